@@ -0,0 +1,553 @@
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>   // std::remove, std::snprintf
+#include <cstdlib>  // std::strtoull
+#include <fstream>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/core/AsyncTradeWriter.h"
+#include "../src/core/CsvReader.h"
+#include "../src/core/CsvScanner.h"
+#include "../src/core/EventStore.h"
+#include "../src/core/FixedPointStrategy.h"
+#include "../src/core/KWayMerger.h"
+#include "../src/core/MappedFile.h"
+#include "../src/core/MarketData.h"
+#include "../src/core/MultiConfigEngine.h"
+#include "../src/core/ParallelCsvReader.h"
+#include "../src/core/ParameterSweep.h"
+#include "../src/core/PnlTracker.h"
+#include "../src/core/PriceParser.h"
+#include "../src/core/SimulationEngine.h"
+#include "../src/core/Strategy.h"
+#include "../src/core/StreamMerger.h"
+#include "../src/core/ThreadPool.h"
+#include "../src/core/TradeLog.h"
+
+using namespace ArbSim;
+
+using Clock = std::chrono::steady_clock;
+
+//================= Helpers =================//
+
+static double Sec(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// RAII helper for generated data files - auto-deletes on scope exit
+class TempFile {
+public:
+    explicit TempFile(const std::string& path) : path_(path) {}
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    ~TempFile() { std::remove(path_.c_str()); }
+
+    const std::string& Path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+// Writes a synthetic 7-column quote file shaped like the production data
+static void WriteSyntheticCsv(const std::string& path, const char* instrument, std::uint64_t rows)
+{
+    std::ofstream f(path, std::ios::binary);
+    if (!f)
+        throw std::runtime_error("Bench: failed to create " + path);
+
+    std::mt19937_64 rng(7);
+    long long t = 1544166000000000000LL;
+    double px = 10928.5;
+
+    char line[128];
+    for (std::uint64_t i = 0; i < rows; ++i)
+    {
+        t += static_cast<long long>(rng() % 4) * 1000000LL;
+        px += (static_cast<int>(rng() % 3) - 1) * 0.5;
+        const int n = std::snprintf(line, sizeof(line), "%lld,%s,0,%d,%.10g,%.10g,%d\n",
+                                    t, instrument, static_cast<int>(rng() % 50), px, px + 0.5,
+                                    static_cast<int>(rng() % 50));
+        f.write(line, n);
+    }
+}
+
+static void PrintRate(const char* name, std::uint64_t events, double sec, double mb)
+{
+    std::cout << name << ": " << events << " events in " << (sec * 1000.0) << " ms, "
+              << (sec > 0.0 ? events / sec : 0.0) << " events/sec";
+    if (mb > 0.0)
+        std::cout << ", " << (sec > 0.0 ? mb / sec : 0.0) << " MB/s";
+    std::cout << "\n";
+}
+
+//================= CsvReader benchmarks =================//
+
+static double TimeCsvReader(const std::string& path, CsvReaderMode mode, std::uint64_t& events)
+{
+    const auto t0 = Clock::now();
+    CsvReader reader(path, mode);
+    MarketEvent ev{};
+    events = 0;
+    while (reader.ReadNextEvent(ev))
+        ++events;
+    return Sec(t0, Clock::now());
+}
+
+void BenchCsvReaderModes(std::uint64_t rows)
+{
+    TempFile file("_bench_csv_reader.csv");
+    WriteSyntheticCsv(file.Path(), "FutureA", rows);
+
+    std::ifstream probe(file.Path(), std::ios::binary | std::ios::ate);
+    const double mb = static_cast<double>(probe.tellg()) / (1024.0 * 1024.0);
+    probe.close();
+
+    std::cout << "\nCsvReader (" << rows << " rows, " << mb << " MB)\n";
+
+    // Warm the page cache so both modes measure parsing, not the first cold read
+    std::uint64_t events = 0;
+    TimeCsvReader(file.Path(), CsvReaderMode::Stream, events);
+
+    const double streamSec = TimeCsvReader(file.Path(), CsvReaderMode::Stream, events);
+    PrintRate("  Stream (ifstream)", events, streamSec, mb);
+
+    const double mappedSec = TimeCsvReader(file.Path(), CsvReaderMode::MemoryMapped, events);
+    PrintRate("  MemoryMapped     ", events, mappedSec, mb);
+
+    std::cout << "  Speedup: " << (mappedSec > 0.0 ? streamSec / mappedSec : 0.0) << "x\n";
+}
+
+//================= CsvScanner benchmarks =================//
+
+void BenchParallelCsvReader(std::uint64_t rows)
+{
+    TempFile file("bench_parallel.csv");
+    WriteSyntheticCsv(file.Path(), "FutureA", rows);
+    const double mb = static_cast<double>(MappedFile(file.Path()).Size()) / (1024.0 * 1024.0);
+
+    std::cout << "\n=== ParallelCsvReader (" << rows << " rows, " << mb << " MB) ===\n";
+
+    std::uint64_t events = 0;
+    const double serialSec = TimeCsvReader(file.Path(), CsvReaderMode::MemoryMapped, events);
+    PrintRate("CsvReader (1 thread)", events, serialSec, mb);
+
+    const unsigned hw = std::thread::hardware_concurrency();
+    for (unsigned threads : { 1u, 2u, 4u, 8u, 16u })
+    {
+        if (threads > 2 * hw)
+            break;
+
+        ThreadPool pool(threads);
+        const auto t0 = Clock::now();
+        ParallelCsvReader reader(file.Path(), pool);
+        MarketEvent ev{};
+        events = 0;
+        while (reader.ReadNextEvent(ev))
+            ++events;
+        const double sec = Sec(t0, Clock::now());
+
+        const std::string name = "ParallelCsvReader (" + std::to_string(threads) + " threads)";
+        PrintRate(name.c_str(), events, sec, mb);
+        std::cout << "  speedup vs serial: " << (sec > 0.0 ? serialSec / sec : 0.0) << "x\n";
+    }
+}
+
+//================= Main loop benchmarks =================//
+
+static StrategyParams BenchStrategyParams()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -1e12; // never stop: measure the full stream
+    return p;
+}
+
+void BenchMergeLoop(std::uint64_t rows)
+{
+    TempFile fileA("bench_merge_a.csv");
+    TempFile fileB("bench_merge_b.csv");
+    WriteSyntheticCsv(fileA.Path(), "FutureA", rows / 2);
+    WriteSyntheticCsv(fileB.Path(), "FutureB", rows / 2);
+
+    std::cout << "\n=== Merge + engine loop (" << rows << " events) ===\n";
+
+    {
+        CsvReader readerA(fileA.Path());
+        CsvReader readerB(fileB.Path());
+        StreamMerger merger(readerA, readerB);
+        std::string tradeBuf;
+        SimulationEngine engine(Strategy(BenchStrategyParams()), PnlTracker(), tradeBuf);
+
+        const auto t0 = Clock::now();
+        MarketEvent ev{};
+        std::uint64_t events = 0;
+        while (merger.ReadNext(ev))
+        {
+            engine.OnEvent(ev);
+            ++events;
+        }
+        PrintRate("ReadNext + OnEvent", events, Sec(t0, Clock::now()), 0.0);
+    }
+
+    {
+        CsvReader readerA(fileA.Path());
+        CsvReader readerB(fileB.Path());
+        StreamMerger merger(readerA, readerB);
+        std::string tradeBuf;
+        SimulationEngine engine(Strategy(BenchStrategyParams()), PnlTracker(), tradeBuf);
+
+        const auto t0 = Clock::now();
+        std::vector<MarketEvent> batch(4096);
+        std::uint64_t events = 0;
+        size_t n = 0;
+        while ((n = merger.ReadBatch(batch.data(), batch.size())) > 0)
+            events += engine.OnEvents(batch.data(), n);
+        PrintRate("ReadBatch + OnEvents", events, Sec(t0, Clock::now()), 0.0);
+    }
+}
+
+// In-memory event store: the merged day held as MarketEvents and replayed
+// straight into the engine, so only event size and engine work remain
+void BenchEventStoreReplay(std::uint64_t rows)
+{
+    TempFile fileA("bench_store_a.csv");
+    TempFile fileB("bench_store_b.csv");
+    WriteSyntheticCsv(fileA.Path(), "FutureA", rows / 2);
+    WriteSyntheticCsv(fileB.Path(), "FutureB", rows / 2);
+
+    std::vector<MarketEvent> store;
+    store.reserve(rows);
+    {
+        CsvReader readerA(fileA.Path());
+        CsvReader readerB(fileB.Path());
+        StreamMerger merger(readerA, readerB);
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+            store.push_back(ev);
+    }
+
+    const double mb = static_cast<double>(store.size() * sizeof(MarketEvent)) / (1024.0 * 1024.0);
+    std::cout << "\n=== Event store replay (" << store.size() << " events, sizeof(MarketEvent) = "
+              << sizeof(MarketEvent) << ", " << mb << " MB) ===\n";
+
+    {
+        std::string tradeBuf;
+        SimulationEngine engine(Strategy(BenchStrategyParams()), PnlTracker(), tradeBuf);
+        const auto t0 = Clock::now();
+        const std::uint64_t events = engine.OnEvents(store.data(), store.size());
+        PrintRate("OnEvents (MarketEvent array)", events, Sec(t0, Clock::now()), mb);
+    }
+
+    EventStore columns;
+    columns.Reserve(store.size());
+    for (const MarketEvent& ev : store)
+        columns.Append(ev);
+    const double columnsMb = static_cast<double>(columns.MemoryBytes()) / (1024.0 * 1024.0);
+    {
+        std::string tradeBuf;
+        SimulationEngine engine(Strategy(BenchStrategyParams()), PnlTracker(), tradeBuf);
+        const auto t0 = Clock::now();
+        const std::uint64_t events = engine.OnEvents(columns, 0, columns.Size());
+        PrintRate("OnEvents (EventStore columns)", events, Sec(t0, Clock::now()), columnsMb);
+    }
+    {
+        std::string tradeBuf;
+        SimulationEngine engine(FixedPointStrategy(BenchStrategyParams()), PnlTracker(), tradeBuf);
+        const auto t0 = Clock::now();
+        const std::uint64_t events = engine.OnEvents(columns, 0, columns.Size());
+        PrintRate("OnEvents (EventStore, FixedPoint)", events, Sec(t0, Clock::now()), columnsMb);
+    }
+}
+
+//================= Merger benchmarks =================//
+
+// Replays pre-generated events so the merge itself is measured, not parsing
+class VectorEventSource : public IEventSource {
+public:
+    explicit VectorEventSource(const std::vector<MarketEvent>& events) : events_(events) {}
+
+    const std::string& GetFilePath() const override { return name_; }
+
+    bool ReadNextEvent(MarketEvent& event) override
+    {
+        if (pos_ == events_.size())
+            return false;
+        event = events_[pos_++];
+        return true;
+    }
+
+    size_t ReadEvents(MarketEvent* out, size_t max) override
+    {
+        const size_t n = std::min(max, events_.size() - pos_);
+        std::copy_n(events_.data() + pos_, n, out);
+        pos_ += n;
+        return n;
+    }
+
+private:
+    const std::vector<MarketEvent>& events_;
+    size_t pos_ = 0;
+    std::string name_ = "vector";
+};
+
+void BenchTradeSinks(std::uint64_t rows)
+{
+    TempFile fileA("bench_sinks_a.csv");
+    TempFile fileB("bench_sinks_b.csv");
+    WriteSyntheticCsv(fileA.Path(), "FutureA", rows / 2);
+    WriteSyntheticCsv(fileB.Path(), "FutureB", rows / 2);
+
+    CsvReader readerA(fileA.Path());
+    CsvReader readerB(fileB.Path());
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    // Zero edge and a wide limit: a fill on most events
+    StrategyParams p = BenchStrategyParams();
+    p.MinArbitrageEdge = 0.0;
+    p.MaxAbsExposureLots = 1000000;
+
+    std::cout << "\n=== Trade sinks (" << store.Size() << " events, high activity) ===\n";
+
+    {
+        std::string tradeBuf;
+        tradeBuf.reserve(kTradeLogBufferSize);
+        SimulationEngine engine(Strategy(p), PnlTracker(), tradeBuf);
+        const auto t0 = Clock::now();
+        const std::uint64_t events = engine.OnEvents(store, 0, store.Size());
+        const double sec = Sec(t0, Clock::now());
+        PrintRate("In-memory text log", events, sec, 0.0);
+        std::cout << "  " << engine.GetPnl().GetTradedLots() << " lots, log " << tradeBuf.size() / (1024.0 * 1024.0)
+                  << " MB in RAM\n";
+    }
+
+    for (TradeLogFormat format : { TradeLogFormat::Text, TradeLogFormat::Binary })
+    {
+        TempFile out(format == TradeLogFormat::Text ? "bench_trades.txt" : "bench_trades.bin");
+        AsyncTradeWriter writer(out.Path(), format);
+        SimulationEngine engine(Strategy(p), PnlTracker(), writer);
+        const auto t0 = Clock::now();
+        const std::uint64_t events = engine.OnEvents(store, 0, store.Size());
+        const double sec = Sec(t0, Clock::now());
+        writer.Close();
+        const double drainSec = Sec(t0, Clock::now());
+        PrintRate(format == TradeLogFormat::Text ? "AsyncTradeWriter text" : "AsyncTradeWriter binary", events, sec, 0.0);
+        std::cout << "  " << writer.GetCount() << " trades, ring full stalls " << writer.GetFullStalls()
+                  << ", drained " << drainSec * 1000.0 << " ms after start\n";
+    }
+}
+
+void BenchMultiConfigEngine(std::uint64_t rows)
+{
+    TempFile fileA("bench_multi_a.csv");
+    TempFile fileB("bench_multi_b.csv");
+    WriteSyntheticCsv(fileA.Path(), "FutureA", rows / 2);
+    WriteSyntheticCsv(fileB.Path(), "FutureB", rows / 2);
+
+    CsvReader readerA(fileA.Path());
+    CsvReader readerB(fileB.Path());
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    std::cout << "\n=== Multi-config sweep (" << store.Size() << " events, one thread) ===\n";
+
+    ThreadPool pool(1);
+    for (size_t configs : { size_t(8), size_t(16) })
+    {
+        // Never-stopping sets, so every lane sees the full stream
+        std::vector<double> edges;
+        for (size_t k = 0; k < configs / 2; ++k)
+            edges.push_back(0.5 + 0.25 * static_cast<double>(k));
+        const std::vector<StrategyParams> grid = MakeSweepGrid(edges, { 1, 3 }, { -1e12 });
+
+        const std::uint64_t laneEvents = static_cast<std::uint64_t>(store.Size()) * grid.size();
+        const auto t0 = Clock::now();
+        RunSweep(store, 0, store.Size(), grid, pool, 1);
+        const double perConfig = Sec(t0, Clock::now());
+        const auto t1 = Clock::now();
+        RunSweep(store, 0, store.Size(), grid, pool, grid.size());
+        const double lockstep = Sec(t1, Clock::now());
+
+        std::cout << "  K=" << grid.size() << ": " << grid.size() << " SimulationEngine runs " << perConfig
+                  << " s, one MultiConfigEngine run " << lockstep << " s ("
+                  << static_cast<double>(laneEvents) / lockstep / 1e6 << " M lane-events/s, "
+                  << perConfig / lockstep << "x)\n";
+    }
+}
+
+static std::vector<std::vector<MarketEvent>> MakeStreams(size_t sources, std::uint64_t totalEvents)
+{
+    std::mt19937_64 rng(11);
+    std::vector<std::vector<MarketEvent>> streams(sources);
+    for (auto& stream : streams)
+    {
+        long long t = 1544166000000000000LL;
+        stream.resize(totalEvents / sources);
+        for (MarketEvent& ev : stream)
+        {
+            t += static_cast<long long>(rng() % 4) * 1000000LL;
+            ev = MarketEvent{};
+            ev.sendingTime = t;
+            ev.instrumentId = InstrumentId::FutureA;
+        }
+    }
+    return streams;
+}
+
+void BenchKWayMerger(std::uint64_t events)
+{
+    std::cout << "\n=== KWayMerger (" << events << " events) ===\n";
+
+    for (size_t k : { size_t(2), size_t(16), size_t(64) })
+    {
+        const auto streams = MakeStreams(k, events);
+        std::vector<std::unique_ptr<VectorEventSource>> owned;
+        std::vector<IEventSource*> sources;
+        for (const auto& stream : streams)
+        {
+            owned.push_back(std::make_unique<VectorEventSource>(stream));
+            sources.push_back(owned.back().get());
+        }
+
+        KWayMerger merger(sources);
+        std::vector<MarketEvent> batch(4096);
+        std::uint64_t merged = 0;
+        size_t n = 0;
+        const auto t0 = Clock::now();
+        while ((n = merger.ReadBatch(batch.data(), batch.size())) > 0)
+            merged += n;
+        const std::string name = "KWayMerger (" + std::to_string(k) + " sources)";
+        PrintRate(name.c_str(), merged, Sec(t0, Clock::now()), 0.0);
+
+        if (k == 2)
+        {
+            VectorEventSource a(streams[0]), b(streams[1]);
+            StreamMerger pairwise(a, b);
+            merged = 0;
+            const auto t1 = Clock::now();
+            while ((n = pairwise.ReadBatch(batch.data(), batch.size())) > 0)
+                merged += n;
+            PrintRate("StreamMerger (2 sources)", merged, Sec(t1, Clock::now()), 0.0);
+        }
+    }
+}
+
+void BenchCsvScanner(std::uint64_t rows)
+{
+    TempFile file("_bench_csv_scanner.csv");
+    WriteSyntheticCsv(file.Path(), "FutureB", rows);
+
+    MappedFile mapped(file.Path());
+    const char* data = mapped.Data();
+    const std::size_t size = mapped.Size();
+    const double mb = static_cast<double>(size) / (1024.0 * 1024.0);
+
+    // Same block size as CsvReader so the index stays cache-resident
+    const std::size_t block = 64 * 1024;
+    std::vector<uint32_t> index(block);
+
+    std::cout << "\nCsvScanner (" << mb << " MB, active: " << ScannerKindName(DetectScannerKind()) << ")\n";
+
+    for (ScannerKind kind : { ScannerKind::Scalar, ScannerKind::Sse2, ScannerKind::Avx2 })
+    {
+        const auto t0 = Clock::now();
+        std::uint64_t hits = 0;
+        for (std::size_t off = 0; off < size; off += block)
+        {
+            const std::size_t len = (size - off < block) ? size - off : block;
+            hits += ScanStructural(kind, data + off, data + off + len, index.data());
+        }
+        const double sec = Sec(t0, Clock::now());
+        std::cout << "  " << ScannerKindName(kind) << ": " << hits << " separators, "
+                  << (sec > 0.0 ? mb / sec : 0.0) << " MB/s\n";
+    }
+}
+
+//================= PriceParser benchmarks =================//
+
+void BenchPriceParser(std::uint64_t count)
+{
+    // NUL-separated price strings so strtod sees the same bytes as the others
+    std::mt19937_64 rng(11);
+    std::string text;
+    std::vector<std::size_t> offsets;
+    char buf[32];
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        const double px = 10000.0 + static_cast<double>(rng() % 400000) * 0.25;
+        const int n = std::snprintf(buf, sizeof(buf), "%.10g", px);
+        offsets.push_back(text.size());
+        text.append(buf, static_cast<std::size_t>(n));
+        text.push_back('\0');
+    }
+    offsets.push_back(text.size());
+
+    std::cout << "\nPriceParser (" << count << " prices -> int64 " << kPnlMultiplier << "ths)\n";
+
+    auto run = [&](const char* name, auto parse) {
+        const auto t0 = Clock::now();
+        std::int64_t checksum = 0;
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            const char* b = text.data() + offsets[i];
+            const char* e = text.data() + offsets[i + 1] - 1;
+            checksum += parse(b, e);
+        }
+        const double sec = Sec(t0, Clock::now());
+        std::cout << "  " << name << ": " << (sec * 1e9 / static_cast<double>(count)) << " ns/price (checksum "
+                  << checksum << ")\n";
+    };
+
+    run("strtod + llround   ", [](const char* b, const char*) {
+        return static_cast<std::int64_t>(std::llround(std::strtod(b, nullptr) * static_cast<double>(kPnlMultiplier)));
+    });
+    run("from_chars + llround", [](const char* b, const char* e) {
+        double v = 0.0;
+        std::from_chars(b, e, v);
+        return static_cast<std::int64_t>(std::llround(v * static_cast<double>(kPnlMultiplier)));
+    });
+    run("ParsePrice         ", [](const char* b, const char* e) {
+        double v = 0.0;
+        std::int64_t scaled = 0;
+        ParsePrice(b, e, scaled, v);
+        return scaled;
+    });
+}
+
+//================= Runner =================//
+
+int main(int argc, char* argv[])
+{
+    // Usage: ArbSimBench [rows]
+    const std::uint64_t rows = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 5'000'000ULL;
+
+    try
+    {
+        BenchCsvReaderModes(rows);
+        BenchParallelCsvReader(rows);
+        BenchMergeLoop(rows);
+        BenchEventStoreReplay(rows);
+        BenchMultiConfigEngine(rows);
+        BenchTradeSinks(rows);
+        BenchKWayMerger(rows);
+        BenchCsvScanner(rows);
+        BenchPriceParser(rows);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[FAILED] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <exception>
 #include <stdexcept>
@@ -5,17 +6,51 @@
 #include <cmath>
 #include <sstream>
 #include <fstream>
+#include <cstddef>  // offsetof
 #include <cstdio>   // std::remove
 #include <vector>
 #include <cassert>
+#include <cstdlib>  // std::strtod
+#include <cstring>  // std::memcmp
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#ifdef ARBSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 #include <windows.h>
 
+#include "../src/core/AsyncTradeWriter.h"
+#include "../src/core/BatchRunner.h"
+#include "../src/core/BinaryEventFile.h"
+#include "../src/core/Checkpoint.h"
 #include "../src/core/CsvReader.h"
+#include "../src/core/CsvScanner.h"
+#include "../src/core/DecompressingStream.h"
+#include "../src/core/EventSourceFactory.h"
+#include "../src/core/EventStore.h"
+#include "../src/core/FixedPointStrategy.h"
+#include "../src/core/KWayMerger.h"
+#include "../src/core/OutputBuffer.h"
 #include "../src/core/StreamMerger.h"
 #include "../src/core/MarketData.h"
+#include "../src/core/ParallelCsvReader.h"
+#include "../src/core/ParameterSweep.h"
+#include "../src/core/PnlSeries.h"
 #include "../src/core/PnlTracker.h"
+#include "../src/core/PrefetchingEventSource.h"
+#include "../src/core/PriceParser.h"
 #include "../src/core/Strategy.h"
+#include "../src/core/ThreadPool.h"
+#include "../src/core/TimeIndex.h"
+#include "../src/core/TimelineCache.h"
+#include "../src/core/TimeWindowEventSource.h"
+#include "../src/core/TradeLog.h"
 #include "../src/core/SimulationEngine.h"
 #include "../src/config/Config.h"
 
@@ -67,8 +102,8 @@ static MarketEvent MakeQuote(long long t, InstrumentId inst, double bid, double
     e.instrumentId = inst;
     e.eventTypeId = 0;
     e.bidSize = bidSize;
-    e.bid = bid;
-    e.ask = ask;
+    e.bidTicks = PriceToTicks(bid);
+    e.askTicks = PriceToTicks(ask);
     e.askSize = askSize;
     return e;
 }
@@ -227,6 +262,805 @@ void TestSimulationEngine_StopLoss_ClosesAsTradeAndStops()
     PrintOk("SimulationEngine stop loss closes as trade and stops");
 }
 
+void TestSimulationEngine_OnEvents_StopsAtStopLoss()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 10;
+    p.StopLossPnl = -0.5;
+
+    std::string tradeBuf;
+    SimulationEngine eng(Strategy(p), PnlTracker(), tradeBuf);
+
+    // Same scenario as above: the third event triggers the stop
+    const MarketEvent events[] = {
+        MakeQuote(100, InstrumentId::FutureA, 101.0, 102.0),
+        MakeQuote(101, InstrumentId::FutureB, 99.0, 100.0),
+        MakeQuote(102, InstrumentId::FutureB, 98.0, 99.0),
+        MakeQuote(103, InstrumentId::FutureA, 50.0, 51.0),
+        MakeQuote(104, InstrumentId::FutureB, 200.0, 201.0),
+    };
+
+    Require(eng.OnEvents(events, 5) == 3, "SimEngine: OnEvents should stop after the stop-loss event");
+    Require(eng.IsStopped(), "SimEngine: expected stopped");
+    Require(CountSubstr(tradeBuf, "STOP_LOSS_CLOSE") == 1, "SimEngine: expected STOP_LOSS_CLOSE tag");
+    PrintOk("SimulationEngine OnEvents stops at stop loss");
+}
+
+static std::string RunEngineOverEvents(const StrategyParams& p, const std::vector<MarketEvent>& events)
+{
+    std::string tradeBuf;
+    SimulationEngine eng(Strategy(p), PnlTracker(), tradeBuf);
+    const size_t done = eng.OnEvents(events.data(), events.size());
+    eng.OnEndOfDay(events[done - 1].sendingTime);
+    std::ostringstream out;
+    out << tradeBuf << done << "\n";
+    eng.PrintSummary(out);
+    return out.str();
+}
+
+static std::string RunEngineOverStore(const StrategyParams& p, const EventStore& store,
+                                      const std::vector<MarketEvent>& events, size_t split)
+{
+    std::string tradeBuf;
+    SimulationEngine eng(Strategy(p), PnlTracker(), tradeBuf);
+    // Store replay up to split, then per-event: the quote state must carry over
+    size_t done = eng.OnEvents(store, 0, split);
+    if (!eng.IsStopped())
+        done += eng.OnEvents(events.data() + split, events.size() - split);
+    eng.OnEndOfDay(events[done - 1].sendingTime);
+    std::ostringstream out;
+    out << tradeBuf << done << "\n";
+    eng.PrintSummary(out);
+    return out.str();
+}
+
+void TestSimulationEngine_StoreReplayMatchesOnEvents()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB, 7);
+
+    std::vector<MarketEvent> events;
+    for (size_t i = 0; i < store.Size(); ++i)
+        events.push_back(store.Get(i));
+    Require(!events.empty(), "EventStore: expected events");
+    Require(store.LowerBound(events[events.size() / 2].sendingTime) <= events.size() / 2, "EventStore: LowerBound past the event");
+
+    for (double stopLoss : { -1e12, -50.0, -5.0 })
+    {
+        // -5 is a tight stop loss: covers a replay that stops early
+        StrategyParams p{};
+        p.MinArbitrageEdge = 1.5;
+        p.MaxAbsExposureLots = 2;
+        p.StopLossPnl = stopLoss;
+
+        const std::string expected = RunEngineOverEvents(p, events);
+        Require(RunEngineOverStore(p, store, events, store.Size()) == expected, "EventStore: store replay differs from OnEvents");
+        Require(RunEngineOverStore(p, store, events, store.Size() / 3) == expected, "EventStore: mixed store/per-event replay differs from OnEvents");
+    }
+
+    PrintOk("SimulationEngine store replay matches OnEvents");
+}
+
+void TestParameterSweep_MatchesSequentialRuns()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    const std::vector<StrategyParams> grid = MakeSweepGrid({ 0.5, 1.0, 2.0 }, { 1, 3 }, { -5.0, -1e12 });
+    Require(grid.size() == 12, "Sweep: expected 3 x 2 x 2 parameter sets");
+    Require(grid[1].MinArbitrageEdge == 0.5 && grid[1].MaxAbsExposureLots == 1 && grid[1].StopLossPnl == -1e12,
+            "Sweep: unexpected grid order");
+
+    ThreadPool pool(3);
+    const std::vector<SweepResult> results = RunSweep(store, 0, store.Size(), grid, pool);
+    Require(results.size() == grid.size(), "Sweep: expected one result per parameter set");
+
+    for (size_t k = 0; k < grid.size(); ++k)
+    {
+        std::string tradeBuf;
+        SimulationEngine eng(Strategy(grid[k]), PnlTracker(), tradeBuf);
+        MarketEvent ev{};
+        std::uint64_t events = 0;
+        long long lastTime = 0;
+        for (size_t i = 0; i < store.Size() && !eng.IsStopped(); ++i)
+        {
+            ev = store.Get(i);
+            eng.OnEvent(ev);
+            lastTime = ev.sendingTime;
+            ++events;
+        }
+        eng.OnEndOfDay(lastTime);
+
+        const SweepResult& r = results[k];
+        Require(r.params.MinArbitrageEdge == grid[k].MinArbitrageEdge && r.params.StopLossPnl == grid[k].StopLossPnl,
+                "Sweep: result out of grid order");
+        Require(r.events == events && r.stopped == eng.IsStopped(), "Sweep: event count or stop differs");
+        Require(r.totalPnl == eng.GetTotalPnl() && r.tradedLots == eng.GetPnl().GetTradedLots() &&
+                r.bestPnl == eng.GetPnl().GetBestPnl() && r.worstPnl == eng.GetPnl().GetWorstPnl() &&
+                r.maxExposure == eng.GetPnl().GetMaxAbsExposure() &&
+                r.droppedBuys == eng.GetDroppedBuyCount() && r.droppedSells == eng.GetDroppedSellCount(),
+                "Sweep: summary differs from a sequential run");
+    }
+
+    std::ostringstream csv;
+    WriteSweepCsv(csv, results);
+    Require(static_cast<size_t>(CountSubstr(csv.str(), "\n")) == grid.size() + 1, "Sweep: expected a header and one row per set");
+
+    PrintOk("Parameter sweep matches sequential runs");
+}
+
+void TestMultiConfigEngine_MatchesPerConfigEngines()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    // Includes tight stop losses so some lanes stop while others run on
+    const std::vector<StrategyParams> grid =
+        MakeSweepGrid({ 0.25, 0.5, 1.0, 1.5, 2.0 }, { 1, 2, 4 }, { -1.0, -5.0, -50.0, -1e12 });
+
+    ThreadPool pool(2);
+    const std::vector<SweepResult> expected = RunSweep(store, 0, store.Size(), grid, pool, 1);
+    for (size_t lanes : { size_t(4), size_t(7), grid.size() })
+    {
+        const std::vector<SweepResult> got = RunSweep(store, 0, store.Size(), grid, pool, lanes);
+        Require(got.size() == expected.size(), "MultiConfig: result count differs");
+        for (size_t k = 0; k < got.size(); ++k)
+        {
+            const SweepResult& a = got[k];
+            const SweepResult& b = expected[k];
+            Require(a.params.MinArbitrageEdge == b.params.MinArbitrageEdge && a.params.StopLossPnl == b.params.StopLossPnl &&
+                    a.params.MaxAbsExposureLots == b.params.MaxAbsExposureLots, "MultiConfig: result out of grid order");
+            Require(a.events == b.events && a.stopped == b.stopped && a.totalPnl == b.totalPnl &&
+                    a.bestPnl == b.bestPnl && a.worstPnl == b.worstPnl && a.maxExposure == b.maxExposure &&
+                    a.tradedLots == b.tradedLots && a.droppedBuys == b.droppedBuys && a.droppedSells == b.droppedSells,
+                    "MultiConfig: lane differs from SimulationEngine for grid entry " + std::to_string(k));
+        }
+    }
+
+    PrintOk("MultiConfigEngine lanes match per-config SimulationEngine runs");
+}
+
+void TestFixedPointStrategy_ThresholdTicksExact()
+{
+    for (double threshold : { 1.0 - kFloatCompareEpsilon, 0.5 - kFloatCompareEpsilon, 0.1, -50.0, -0.3, 1e-7, 0.0, -1e12 })
+    {
+        const int64_t t = FixedPointStrategy::ThresholdTicks(threshold);
+        Require(TicksToPrice(t) >= threshold && TicksToPrice(t - 1) < threshold,
+                "FixedPoint: ThresholdTicks is not the exact boundary for " + std::to_string(threshold));
+    }
+    Require(FixedPointStrategy::ThresholdTicks(-1e300) == std::numeric_limits<int64_t>::min(), "FixedPoint: expected clamp to min");
+    Require(FixedPointStrategy::ThresholdTicks(1e300) == std::numeric_limits<int64_t>::max(), "FixedPoint: expected clamp to max");
+
+    // Around each threshold the tick decision equals the double one
+    StrategyParams p{};
+    p.MinArbitrageEdge = 0.3;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -0.7;
+    const Strategy prices(p);
+    const FixedPointStrategy ticks(p);
+    for (int64_t d = -3; d <= 3; ++d)
+    {
+        const int64_t edge = ticks.GetMinEdgeTicks() + d;
+        const int64_t pnl = ticks.GetStopLossTicks() + d;
+        for (int pos : { -2, 0, 2 })
+        {
+            Require(ticks.DecideTicks(edge, 0, pos, 0) == prices.Decide(TicksToPrice(edge), 0.0, pos, 0.0) &&
+                    ticks.DecideTicks(0, edge, pos, 0) == prices.Decide(0.0, TicksToPrice(edge), pos, 0.0) &&
+                    ticks.DecideTicks(edge, edge, pos, pnl) == prices.Decide(TicksToPrice(edge), TicksToPrice(edge), pos, TicksToPrice(pnl)),
+                    "FixedPoint: decision differs from Strategy at the threshold");
+        }
+    }
+
+    PrintOk("FixedPointStrategy threshold ticks are exact");
+}
+
+// Runs one policy over the whole store, as Main does, and returns the trade
+// log followed by the summary
+template <typename StrategyT>
+static std::string RunPolicyOverStore(StrategyT strategy, const EventStore& store)
+{
+    std::string tradeBuf;
+    SimulationEngine<StrategyT> eng(std::move(strategy), PnlTracker(), tradeBuf);
+    const size_t done = eng.OnEvents(store, 0, store.Size());
+    if (done > 0)
+        eng.OnEndOfDay(store.SendingTime()[done - 1]);
+    std::ostringstream out;
+    eng.PrintSummary(out);
+    return tradeBuf + out.str() + "Events: " + std::to_string(done) + "\n";
+}
+
+void TestFixedPointStrategy_MatchesDoublePath()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    // Trade logs, summaries and stop points must be identical
+    for (const StrategyParams& p :
+         MakeSweepGrid({ 0.0, 0.25, 0.5, 1.0, 1.5, 2.0 }, { 1, 2, 4 }, { -1.0, -5.0, -50.0, -1e12 }))
+    {
+        Require(RunPolicyOverStore(Strategy(p), store) == RunPolicyOverStore(FixedPointStrategy(p), store),
+                "FixedPoint: run differs from Strategy for edge " + std::to_string(p.MinArbitrageEdge) +
+                ", lots " + std::to_string(p.MaxAbsExposureLots) + ", stop " + std::to_string(p.StopLossPnl));
+    }
+
+    PrintOk("FixedPointStrategy runs match Strategy on the sample data");
+}
+
+// Test-only policy: no IStrategy base, only the static interface
+struct SellOnlyStrategy
+{
+    double minEdge;
+    StrategyAction Decide(double sellEdge, double /*buyEdge*/, int positionB, double /*currentPnl*/) const
+    {
+        return (sellEdge >= minEdge && positionB > -1) ? StrategyAction::SellB : StrategyAction::None;
+    }
+};
+
+static_assert(IsStrategyPolicy<Strategy>::value, "Strategy must satisfy the policy interface");
+static_assert(IsStrategyPolicy<SellOnlyStrategy>::value, "SellOnlyStrategy must satisfy the policy interface");
+static_assert(!IsStrategyPolicy<StrategyParams>::value, "StrategyParams has no Decide()");
+
+void TestSimulationEngine_CustomStrategyPolicy()
+{
+    std::string tradeBuf;
+    SimulationEngine<SellOnlyStrategy> eng(SellOnlyStrategy{ 1.0 }, PnlTracker(), tradeBuf);
+
+    eng.OnEvent(MakeQuote(1, InstrumentId::FutureA, 99.0, 100.0, 5, 5));
+    eng.OnEvent(MakeQuote(2, InstrumentId::FutureB, 101.0, 102.0, 5, 5)); // sellEdge = 1 -> sell
+    eng.OnEvent(MakeQuote(3, InstrumentId::FutureB, 101.0, 102.0, 5, 5)); // at the policy's limit
+    eng.OnEvent(MakeQuote(4, InstrumentId::FutureA, 103.0, 104.0, 5, 5)); // buyEdge = 1, ignored
+
+    Require(eng.GetPnl().GetPositionB() == -1, "Custom policy: expected one sell");
+    Require(CountSubstr(tradeBuf, ",SELL,") == 1 && CountSubstr(tradeBuf, ",BUY,") == 0,
+            "Custom policy: expected only its SELL in the trade log");
+
+    PrintOk("SimulationEngine runs a custom strategy policy");
+}
+
+// Full-day run of one parameter set with the fills going to sink
+static void RunStrategyIntoSink(const EventStore& store, ITradeSink& sink)
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 0.5;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -5.0;
+    SimulationEngine eng(Strategy(p), PnlTracker(), sink);
+    const size_t done = eng.OnEvents(store, 0, store.Size());
+    if (done > 0)
+        eng.OnEndOfDay(store.SendingTime()[done - 1]);
+}
+
+void TestAsyncTradeWriter_MatchesInMemoryLog()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    std::string expected;
+    StringTradeSink memory(expected);
+    RunStrategyIntoSink(store, memory);
+    Require(!expected.empty(), "AsyncTradeWriter: sample run produced no trades");
+
+    // A tiny ring forces the simulation thread to wait for the writer
+    TempFile text("Data/_tmp_trades.txt");
+    {
+        AsyncTradeWriter writer(text.Path(), TradeLogFormat::Text, 8);
+        RunStrategyIntoSink(store, writer);
+        writer.Close();
+        Require(writer.GetCount() == static_cast<uint64_t>(CountSubstr(expected, "\n")), "AsyncTradeWriter: count differs");
+    }
+    std::ifstream in(text.Path(), std::ios::binary);
+    const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Require(written == expected, "AsyncTradeWriter: text file differs from the in-memory log");
+
+    TempFile binary("Data/_tmp_trades.bin");
+    {
+        AsyncTradeWriter writer(binary.Path(), TradeLogFormat::Binary, 8);
+        RunStrategyIntoSink(store, writer);
+    } // closed by the destructor
+    const std::vector<TradeRecord> trades = ReadTradeLogFile(binary.Path());
+    std::string formatted;
+    for (size_t i = 0; i < trades.size(); ++i)
+    {
+        Require(trades[i].sequence == i, "AsyncTradeWriter: records out of sequence");
+        char line[160];
+        formatted.append(line, FormatTrade(trades[i], line, sizeof(line)));
+        formatted.push_back('\n');
+    }
+    Require(formatted == expected, "AsyncTradeWriter: binary records differ from the in-memory log");
+
+    PrintOk("AsyncTradeWriter text and binary logs match the in-memory log");
+}
+
+void TestOutputBuffer_MatchesStreamFormatting()
+{
+    const double doubles[] = { 0.0, -0.0, 1.0, -2.5, 10927.5, 0.1, 1.0 / 3.0, 123456.5, 1234567.0,
+                               1e-5, 1e-4, -9.87654321e-7, 1e21, 2.5e-300, 1.7976931348623157e308 };
+    const long long ints[] = { 0, -1, 42, 1544166000001000000LL,
+                               std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max() };
+
+    OutputBuffer out;
+    std::ostringstream expected;
+    for (double d : doubles)
+    {
+        out << d << ',';
+        expected << d << ',';
+    }
+    for (long long v : ints)
+    {
+        out << v << ',';
+        expected << v << ',';
+    }
+    out << std::numeric_limits<size_t>::max() << "\n";
+    expected << std::numeric_limits<size_t>::max() << "\n";
+    Require(out.View() == expected.str(), "OutputBuffer: text differs from std::ostream");
+
+    // FormatTrade's prices are printf %.10g
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<long long> ticks(-100'000'000'000'000LL, 100'000'000'000'000LL);
+    for (int i = 0; i < 10000; ++i)
+    {
+        TradeRecord trade{};
+        trade.time = 1544166000001000000LL + i;
+        trade.priceTicks = i % 2 == 0 ? ticks(rng) : ticks(rng) / 1'000'000 * 500'000;
+        trade.quantity = i % 7 + 1;
+        trade.side = static_cast<uint8_t>(i % 2 == 0 ? Side::Buy : Side::Sell);
+        trade.instrument = static_cast<uint8_t>(InstrumentId::FutureB);
+        trade.reason = static_cast<TradeReason>(i % 3);
+
+        char line[160];
+        const std::string formatted(line, FormatTrade(trade, line, sizeof(line)));
+        char price[64];
+        std::snprintf(price, sizeof(price), "%.10g", TicksToPrice(trade.priceTicks));
+        const std::string tag = trade.reason == TradeReason::StopLoss ? ",STOP_LOSS_CLOSE"
+            : trade.reason == TradeReason::EndOfDay ? ",EOD_CLOSE" : "";
+        const std::string want = std::to_string(trade.time) + (i % 2 == 0 ? ",BUY," : ",SELL,") + "FutureB,"
+            + std::to_string(trade.quantity) + "," + price + tag;
+        Require(formatted == want, "FormatTrade: got '" + formatted + "', expected '" + want + "'");
+    }
+
+    PrintOk("OutputBuffer and FormatTrade match std::ostream and printf formatting");
+}
+
+void TestPnlSeries_WritesNdjsonAndBinary()
+{
+    // Two samples fit the reservation, the rest grow the columns
+    PnlSeries series(2);
+    series.Record(1544166000001000000LL, 0, 0, 0);
+    series.Record(1544166001000000000LL, PriceToTicks(-12.5), PriceToTicks(10927.25), 3);
+    series.Record(1544166002000000000LL, PriceToTicks(0.000001), PriceToTicks(10928.0), -10);
+    for (int i = 0; i < 1000; ++i)
+    {
+        series.Record(1544166003000000000LL + i, PriceToTicks(i * 0.1), PriceToTicks(10929.5), i % 11 - 5);
+    }
+
+    TempFile binary("Data/_tmp_pnl_series.bin");
+    series.WriteFile(binary.Path(), PnlSeriesFormat::Binary);
+    const PnlSeries read = ReadPnlSeriesFile(binary.Path());
+    Require(read.Size() == series.Size(), "PnlSeries: binary sample count differs");
+    for (size_t i = 0; i < series.Size(); ++i)
+    {
+        Require(read.Time()[i] == series.Time()[i] && read.PnlTicks()[i] == series.PnlTicks()[i]
+                && read.MidBTicks()[i] == series.MidBTicks()[i] && read.Position()[i] == series.Position()[i],
+                "PnlSeries: binary sample " + std::to_string(i) + " differs");
+    }
+
+    TempFile ndjson("Data/_tmp_pnl_series.ndjson");
+    series.WriteFile(ndjson.Path(), PnlSeriesFormat::Ndjson);
+    std::ifstream in(ndjson.Path());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);)
+    {
+        lines.push_back(line);
+    }
+    Require(lines.size() == series.Size(), "PnlSeries: NDJSON line count differs");
+    Require(lines[0] == "{\"time\":1544166000001000000,\"pnl\":0,\"midB\":0,\"position\":0}",
+            "PnlSeries: unexpected NDJSON line: " + lines[0]);
+    Require(lines[1] == "{\"time\":1544166001000000000,\"pnl\":-12.5,\"midB\":10927.25,\"position\":3}",
+            "PnlSeries: unexpected NDJSON line: " + lines[1]);
+    Require(lines[2] == "{\"time\":1544166002000000000,\"pnl\":1e-06,\"midB\":10928,\"position\":-10}",
+            "PnlSeries: unexpected NDJSON line: " + lines[2]);
+
+    PrintOk("PnlSeries NDJSON and binary files hold every sample");
+}
+
+void TestDownsamplePnlSeries_KeepsExtremes()
+{
+    // A random walk with one spike and one dip the thinning must keep
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> step(-3, 3);
+    PnlSeries series(100000);
+    long long pnl = 0;
+    for (long long i = 0; i < 100000; ++i)
+    {
+        pnl += step(rng);
+        const long long value = i == 31337 ? 1'000'000 : i == 77777 ? -1'000'000 : pnl;
+        series.Record(1544166000000000000LL + i * 1000, value, 10'927'000'000 + i, i % 5);
+    }
+
+    for (size_t maxPoints : { size_t(4), size_t(5), size_t(1000), size_t(99999) })
+    {
+        const PnlSeries thin = DownsamplePnlSeries(series, maxPoints);
+        const std::string ctx = " (maxPoints " + std::to_string(maxPoints) + ")";
+        // At least one sample per bucket, at most two
+        Require(thin.Size() <= maxPoints && thin.Size() >= 2 + (maxPoints - 2) / 2, "DownsamplePnlSeries: wrong size" + ctx);
+        Require(thin.Time()[0] == series.Time()[0] && thin.Time()[thin.Size() - 1] == series.Time()[series.Size() - 1],
+                "DownsamplePnlSeries: first or last sample dropped" + ctx);
+        bool hasMax = false;
+        bool hasMin = false;
+        for (size_t i = 0; i < thin.Size(); ++i)
+        {
+            // Every kept sample is a whole input row, in time order
+            const size_t row = static_cast<size_t>((thin.Time()[i] - series.Time()[0]) / 1000);
+            Require(thin.PnlTicks()[i] == series.PnlTicks()[row] && thin.MidBTicks()[i] == series.MidBTicks()[row]
+                    && thin.Position()[i] == series.Position()[row], "DownsamplePnlSeries: sample is not an input row" + ctx);
+            Require(i == 0 || thin.Time()[i] > thin.Time()[i - 1], "DownsamplePnlSeries: samples out of order" + ctx);
+            hasMax = hasMax || thin.PnlTicks()[i] == 1'000'000;
+            hasMin = hasMin || thin.PnlTicks()[i] == -1'000'000;
+        }
+        Require(hasMax && hasMin, "DownsamplePnlSeries: PnL extremes dropped" + ctx);
+    }
+
+    const PnlSeries same = DownsamplePnlSeries(series, series.Size());
+    Require(same.Size() == series.Size(), "DownsamplePnlSeries: a series that fits was thinned");
+
+    PrintOk("DownsamplePnlSeries keeps the PnL extremes within the point budget");
+}
+
+void TestBatchRunner_MatchesSingleDayRuns()
+{
+    TempFile manifest("Data/_tmp_manifest.csv");
+    WriteTextFile(manifest.Path(),
+        "# FutureA,FutureB\n"
+        "Data/FutureA.csv,Data/FutureB.csv\n"
+        "\n"
+        "Data/FutureB.csv , Data/FutureA.csv\n"
+        "Data/_missing_A.csv,Data/FutureB.csv\n"
+        "Data/FutureA.csv,Data/FutureB.csv\n");
+    const std::vector<BatchDay> days = ReadBatchManifest(manifest.Path());
+    Require(days.size() == 4 && days[1].futureA == "Data/FutureB.csv" && days[1].futureB == "Data/FutureA.csv",
+            "ReadBatchManifest: unexpected days");
+
+    StrategyParams p{};
+    p.MinArbitrageEdge = 0.5;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -5.0;
+    ThreadPool pool(2);
+    const std::vector<BatchDayResult> results = RunBatch(days, p, pool);
+    Require(results.size() == days.size(), "RunBatch: one result per day");
+    Require(!results[2].error.empty(), "RunBatch: missing file should fail its day");
+
+    int64_t expectedPnlTicks = 0;
+    for (size_t d : { size_t(0), size_t(1), size_t(3) })
+    {
+        CsvReader readerA(days[d].futureA);
+        CsvReader readerB(days[d].futureB);
+        const EventStore store = EventStore::LoadMerged(readerA, readerB);
+        std::string tradeLog;
+        SimulationEngine eng(Strategy(p), PnlTracker(), tradeLog);
+        const size_t done = eng.OnEvents(store, 0, store.Size());
+        eng.OnEndOfDay(store.SendingTime()[done - 1]);
+
+        const BatchDayResult& r = results[d];
+        const std::string ctx = " (day " + std::to_string(d) + ")";
+        Require(r.error.empty(), "RunBatch: day failed: " + r.error);
+        Require(r.events == done && r.stopped == eng.IsStopped(), "RunBatch: events differ" + ctx);
+        Require(r.totalPnlTicks == eng.GetPnl().GetTotalPnlTicks() && r.bestPnl == eng.GetPnl().GetBestPnl()
+                && r.worstPnl == eng.GetPnl().GetWorstPnl(), "RunBatch: PnL differs" + ctx);
+        Require(r.tradedLots == eng.GetPnl().GetTradedLots() && r.maxExposure == eng.GetPnl().GetMaxAbsExposure()
+                && r.droppedBuys == eng.GetDroppedBuyCount() && r.droppedSells == eng.GetDroppedSellCount(),
+                "RunBatch: counters differ" + ctx);
+        Require(r.trades == static_cast<uint64_t>(CountSubstr(tradeLog, "\n")), "RunBatch: trade count differs" + ctx);
+        expectedPnlTicks += r.totalPnlTicks;
+    }
+
+    const BatchTotal total = SumBatch(results);
+    Require(total.days == 3 && total.failedDays == 1, "SumBatch: day counts differ");
+    Require(total.totalPnl == TicksToPrice(expectedPnlTicks), "SumBatch: total PnL differs");
+    Require(total.tradedLots == results[0].tradedLots + results[1].tradedLots + results[3].tradedLots,
+            "SumBatch: traded lots differ");
+
+    // Data options: a time window, parse pool and prefetch per day
+    {
+        CsvReader readerA(days[0].futureA);
+        CsvReader readerB(days[0].futureB);
+        const EventStore store = EventStore::LoadMerged(readerA, readerB);
+        BatchDataOptions data;
+        data.startTime = store.SendingTime()[store.Size() / 4];
+        data.endTime = store.SendingTime()[store.Size() / 2];
+        ThreadPool parsePool(2);
+        data.parsePool = &parsePool;
+        data.prefetch = true;
+        const std::vector<BatchDayResult> windowed = RunBatch({ days[0] }, p, pool, data);
+
+        const size_t begin = store.LowerBound(data.startTime);
+        const size_t end = store.LowerBound(data.endTime);
+        std::string tradeLog;
+        SimulationEngine eng(Strategy(p), PnlTracker(), tradeLog);
+        const size_t done = eng.OnEvents(store, begin, end);
+        eng.OnEndOfDay(store.SendingTime()[begin + done - 1]);
+        Require(windowed[0].error.empty(), "RunBatch: windowed day failed: " + windowed[0].error);
+        Require(windowed[0].events == done && windowed[0].totalPnlTicks == eng.GetPnl().GetTotalPnlTicks()
+                && windowed[0].trades == static_cast<uint64_t>(CountSubstr(tradeLog, "\n")),
+                "RunBatch: windowed day differs from the store window");
+    }
+
+    PrintOk("RunBatch days match single-day engine runs");
+}
+
+void TestCheckpoint_ResumeMatchesFullRun()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+    const int64_t* time = store.SendingTime();
+
+    StrategyParams p{};
+    p.MinArbitrageEdge = 0.5;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -1e9;
+
+    std::string fullLog;
+    SimulationEngine full(Strategy(p), PnlTracker(), fullLog);
+    const size_t done = full.OnEvents(store, 0, store.Size());
+    full.OnEndOfDay(time[done - 1]);
+
+    // Stop after the last event of a timestamp, as the replay loop does
+    size_t split = store.Size() / 2;
+    while (split < store.Size() && time[split] == time[split - 1]) {
+        ++split;
+    }
+    Require(split < store.Size(), "Checkpoint: test data has no timestamp boundary");
+
+    std::string firstLog;
+    SimulationEngine first(Strategy(p), PnlTracker(), firstLog);
+    first.OnEvents(store, 0, split);
+    Checkpoint cp{};
+    cp.engine = first.SaveState();
+    cp.inputHash = CheckpointInputHash({ "Data/FutureA.csv", "Data/FutureB.csv" });
+    cp.events = split;
+    cp.lastTime = time[split - 1];
+
+    TempFile file("Data/_tmp_checkpoint.bin");
+    WriteCheckpointFile(file.Path(), cp);
+    const Checkpoint back = ReadCheckpointFile(file.Path());
+    Require(std::memcmp(&back, &cp, sizeof(cp)) == 0, "Checkpoint: file round trip differs");
+    Require(back.inputHash != CheckpointInputHash({ "Data/FutureB.csv", "Data/FutureA.csv" }),
+            "CheckpointInputHash: swapped inputs hash the same");
+
+    // Resume from the first event after lastTime
+    size_t resumeAt = 0;
+    while (time[resumeAt] <= back.lastTime) {
+        ++resumeAt;
+    }
+    Require(resumeAt == split, "Checkpoint: resume position differs");
+    std::string secondLog;
+    SimulationEngine second(Strategy(p), PnlTracker(), secondLog);
+    second.RestoreState(back.engine);
+    second.OnEvents(store, resumeAt, store.Size());
+    second.OnEndOfDay(time[done - 1]);
+
+    Require(firstLog + secondLog == fullLog, "Checkpoint: resumed trade log differs");
+    const PnlTracker& a = full.GetPnl();
+    const PnlTracker& b = second.GetPnl();
+    Require(a.GetTotalPnlTicks() == b.GetTotalPnlTicks() && a.GetBestPnl() == b.GetBestPnl()
+            && a.GetWorstPnl() == b.GetWorstPnl() && a.GetPositionB() == b.GetPositionB()
+            && a.GetTradedLots() == b.GetTradedLots() && a.GetMaxAbsExposure() == b.GetMaxAbsExposure(),
+            "Checkpoint: resumed PnL differs");
+    Require(full.GetDroppedBuyCount() == second.GetDroppedBuyCount()
+            && full.GetDroppedSellCount() == second.GetDroppedSellCount(),
+            "Checkpoint: resumed counters differ");
+
+    // A file of another kind is rejected
+    WriteTextFile(file.Path(), "not a checkpoint");
+    bool threw = false;
+    try {
+        ReadCheckpointFile(file.Path());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    Require(threw, "ReadCheckpointFile: accepted a non-checkpoint file");
+
+    PrintOk("Resuming from a checkpoint matches the full run");
+}
+
+// A replay driven the way the main loop drives it: merged blocks, periodic
+// checkpoints through CheckpointSchedule (each kept with the trade log length
+// at that point), then the end-of-day close
+struct CheckpointedReplay
+{
+    std::string tradeLog;
+    std::vector<Checkpoint> checkpoints;
+    std::vector<size_t> logSizes;
+    uint64_t events = 0;
+    std::string summary;
+};
+
+template <typename ReadBatchFn>
+static CheckpointedReplay ReplayWithCheckpoints(const StrategyParams& p, ReadBatchFn readBatch, uint64_t every,
+                                                const Checkpoint* resume)
+{
+    CheckpointedReplay run;
+    SimulationEngine eng(Strategy(p), PnlTracker(), run.tradeLog);
+    uint64_t events = 0;
+    long long lastTime = 0;
+    if (resume != nullptr)
+    {
+        eng.RestoreState(resume->engine);
+        events = resume->events;
+        lastTime = resume->lastTime;
+    }
+    CheckpointSchedule schedule(every, events);
+
+    std::vector<MarketEvent> batch(997); // not a multiple of the interval
+    size_t n = 0;
+    while (!eng.IsStopped() && (n = readBatch(batch.data(), batch.size())) > 0)
+    {
+        size_t pos = 0;
+        while (pos < n)
+        {
+            if (schedule.IsDue(events, batch[pos].sendingTime, lastTime))
+            {
+                Checkpoint cp{};
+                cp.engine = eng.SaveState();
+                cp.events = events;
+                cp.lastTime = lastTime;
+                run.checkpoints.push_back(cp);
+                run.logSizes.push_back(run.tradeLog.size());
+                schedule.Taken(events);
+            }
+            const size_t step = static_cast<size_t>(std::min<uint64_t>(n - pos, schedule.EventsUntilDue(events)));
+            const size_t done = eng.OnEvents(batch.data() + pos, step);
+            pos += done;
+            events += done;
+            lastTime = batch[pos - 1].sendingTime;
+            if (eng.IsStopped())
+                break;
+        }
+    }
+    eng.OnEndOfDay(lastTime);
+    run.events = events;
+
+    // The summary without its last line (trade log peak memory differs)
+    std::ostringstream summary;
+    eng.PrintSummary(summary);
+    run.summary = summary.str().substr(0, summary.str().find("Trade log peak memory"));
+    return run;
+}
+
+void TestCheckpoint_ResumeFromReadersMatchesFullRun()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 0.5;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -1e9;
+    const uint64_t every = 40000;
+    constexpr long long kNoEnd = std::numeric_limits<long long>::max();
+
+    TempFile binA("Data/_tmp_resume_a.bin");
+    TempFile binB("Data/_tmp_resume_b.bin");
+    {
+        CsvReader csvA("Data/FutureA.csv");
+        CsvReader csvB("Data/FutureB.csv");
+        BinaryEventWriter writerA(binA.Path());
+        BinaryEventWriter writerB(binB.Path());
+        MarketEvent e{};
+        while (csvA.ReadNextEvent(e))
+            writerA.Write(e);
+        while (csvB.ReadNextEvent(e))
+            writerB.Write(e);
+    }
+
+    // CSV readers through StreamMerger, binary readers through KWayMerger;
+    // from the start, or from a checkpoint's lastTime + 1 as --resume does
+    auto replayCsv = [&](const Checkpoint* resume) {
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        StreamMerger merger(readerA, readerB, kMergeSeed);
+        if (resume != nullptr)
+        {
+            Require(readerA.SeekToTime(resume->lastTime + 1) && readerB.SeekToTime(resume->lastTime + 1),
+                    "Checkpoint: CSV reader cannot seek");
+            merger.SetTimeWindow(resume->lastTime + 1, kNoEnd);
+        }
+        return ReplayWithCheckpoints(p, [&](MarketEvent* out, size_t max) { return merger.ReadBatch(out, max); },
+                                     every, resume);
+    };
+    auto replayBinary = [&](const Checkpoint* resume) {
+        BinaryEventReader readerA(binA.Path());
+        BinaryEventReader readerB(binB.Path());
+        KWayMerger merger({ &readerA, &readerB }, kMergeSeed);
+        if (resume != nullptr)
+        {
+            readerA.SeekToTime(resume->lastTime + 1);
+            readerB.SeekToTime(resume->lastTime + 1);
+            merger.SetTimeWindow(resume->lastTime + 1, kNoEnd);
+        }
+        return ReplayWithCheckpoints(p, [&](MarketEvent* out, size_t max) { return merger.ReadBatch(out, max); },
+                                     every, resume);
+    };
+
+    TempFile file("Data/_tmp_resume_checkpoint.bin");
+    const CheckpointedReplay csvFull = replayCsv(nullptr);
+    const CheckpointedReplay binaryFull = replayBinary(nullptr);
+    Require(binaryFull.tradeLog == csvFull.tradeLog && binaryFull.summary == csvFull.summary,
+            "Checkpoint: binary and CSV replays differ");
+    Require(csvFull.checkpoints.size() >= 2 && csvFull.checkpoints.size() <= csvFull.events / every,
+            "Checkpoint: unexpected number of periodic checkpoints");
+    Require(binaryFull.checkpoints.size() == csvFull.checkpoints.size(), "Checkpoint: cadence differs between inputs");
+
+    for (size_t k = 0; k < csvFull.checkpoints.size(); ++k)
+    {
+        const Checkpoint& cp = csvFull.checkpoints[k];
+        const std::string ctx = " (checkpoint " + std::to_string(k) + ")";
+        // Due every `every` events, taken at the first change of timestamp
+        const uint64_t previous = k == 0 ? 0 : csvFull.checkpoints[k - 1].events;
+        Require(cp.events >= previous + every, "Checkpoint: taken early" + ctx);
+
+        WriteCheckpointFile(file.Path(), cp);
+        const Checkpoint back = ReadCheckpointFile(file.Path());
+        for (const auto& replay : { std::function<CheckpointedReplay(const Checkpoint*)>(replayCsv),
+                                    std::function<CheckpointedReplay(const Checkpoint*)>(replayBinary) })
+        {
+            const CheckpointedReplay resumed = replay(&back);
+            Require(resumed.tradeLog == csvFull.tradeLog.substr(csvFull.logSizes[k]), "Checkpoint: resumed trade log differs" + ctx);
+            Require(resumed.summary == csvFull.summary, "Checkpoint: resumed summary differs" + ctx);
+            Require(resumed.events == csvFull.events, "Checkpoint: resumed event count differs" + ctx);
+            // Later checkpoints keep the same cadence after a resume
+            Require(resumed.checkpoints.size() == csvFull.checkpoints.size() - k - 1,
+                    "Checkpoint: checkpoint count after resuming differs" + ctx);
+            for (size_t j = 0; j < resumed.checkpoints.size(); ++j)
+                Require(resumed.checkpoints[j].events == csvFull.checkpoints[k + 1 + j].events
+                        && resumed.checkpoints[j].lastTime == csvFull.checkpoints[k + 1 + j].lastTime,
+                        "Checkpoint: cadence after resuming differs" + ctx);
+        }
+    }
+
+    // The input key follows file contents: a changed file no longer matches
+    TempFile copyA("Data/_tmp_resume_copy.csv");
+    std::filesystem::copy_file("Data/FutureA.csv", copyA.Path(), std::filesystem::copy_options::overwrite_existing);
+    const uint64_t before = CheckpointInputHash({ copyA.Path(), "Data/FutureB.csv" });
+    Require(before == CheckpointInputHash({ "Data/FutureA.csv", "Data/FutureB.csv" }),
+            "CheckpointInputHash: same contents under another name differ");
+    std::filesystem::resize_file(copyA.Path(), std::filesystem::file_size(copyA.Path()) / 2);
+    Require(CheckpointInputHash({ copyA.Path(), "Data/FutureB.csv" }) != before,
+            "CheckpointInputHash: truncated input hashes the same");
+
+    PrintOk("Resuming readers and mergers from periodic checkpoints matches the full run");
+}
+
+void TestSpillingTradeSink_MatchesInMemoryLog()
+{
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    const EventStore store = EventStore::LoadMerged(readerA, readerB);
+
+    std::string expected;
+    StringTradeSink memory(expected);
+    RunStrategyIntoSink(store, memory);
+
+    // The smallest cap spills many chunks; a large one never spills
+    for (size_t cap : { size_t(0), size_t(5000), size_t(1) << 24 })
+    {
+        SpillingTradeSink sink(cap);
+        RunStrategyIntoSink(store, sink);
+        OutputBuffer out;
+        sink.WriteTo(out);
+        Require(out.View() == expected, "SpillingTradeSink: output differs for cap " + std::to_string(cap));
+        Require(sink.GetPeakMemoryBytes() <= std::max(cap, SpillingTradeSink::kMinMemoryCap),
+                "SpillingTradeSink: buffer grew past the cap");
+        Require((sink.GetSpilledBytes() > 0) == (expected.size() > std::max(cap, SpillingTradeSink::kMinMemoryCap)),
+                "SpillingTradeSink: unexpected spill state for cap " + std::to_string(cap));
+    }
+
+    PrintOk("SpillingTradeSink output matches the in-memory log under a memory cap");
+}
+
 void TestSimulationEngine_EndOfDayClose_Tagged()
 {
     StrategyParams p{};
@@ -242,149 +1076,942 @@ void TestSimulationEngine_EndOfDayClose_Tagged()
     eng.OnEvent(MakeQuote(100, InstrumentId::FutureA, 101.0, 102.0));
     eng.OnEvent(MakeQuote(101, InstrumentId::FutureB, 99.0, 100.0));
 
-    eng.OnEndOfDay(200);
+    eng.OnEndOfDay(200);
+
+    Require(CountSubstr(tradeBuf, "EOD_CLOSE") == 1, "SimEngine: expected EOD_CLOSE tag");
+    PrintOk("SimulationEngine end-of-day close tagged");
+}
+
+//================= Strategy tests (new Decide signature) =================//
+
+void TestStrategyReturnsNone_WhenEdgesSmall()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 2.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    Strategy s(p);
+
+    StrategyAction a = s.Decide(/*sellEdge*/1.999, /*buyEdge*/1.999, /*pos*/0, /*pnl*/0.0);
+    Require(a == StrategyAction::None, "Strategy: expected None when edges are below threshold");
+    PrintOk("Strategy returns None when edges small");
+}
+
+void TestStrategySells_WhenSellEdgeBig()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 2.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    Strategy s(p);
+
+    StrategyAction a = s.Decide(/*sellEdge*/2.0, /*buyEdge*/0.0, /*pos*/0, /*pnl*/0.0);
+    Require(a == StrategyAction::SellB, "Strategy: expected SellB when sellEdge big");
+    PrintOk("Strategy sells when sellEdge big");
+}
+
+void TestStrategyBuys_WhenBuyEdgeBig()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 2.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    Strategy s(p);
+
+    StrategyAction a = s.Decide(/*sellEdge*/0.0, /*buyEdge*/2.0, /*pos*/0, /*pnl*/0.0);
+    Require(a == StrategyAction::BuyB, "Strategy: expected BuyB when buyEdge big");
+    PrintOk("Strategy buys when buyEdge big");
+}
+
+void TestStrategyExposure_PostTrade_AllowsSellFromPlusY()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    Strategy s(p);
+
+    // pos=+2, SellB would go to +1 which is allowed
+    StrategyAction a = s.Decide(/*sellEdge*/1.0, /*buyEdge*/0.0, /*pos*/+2, /*pnl*/0.0);
+    Require(a == StrategyAction::SellB, "Strategy: expected SellB allowed from +Y");
+    PrintOk("Strategy allows SellB from +Y");
+}
+
+void TestStrategyExposure_PostTrade_BlocksBuyAtPlusY()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    Strategy s(p);
+
+    // pos=+2, BuyB would go to +3 which is blocked
+    StrategyAction a = s.Decide(/*sellEdge*/0.0, /*buyEdge*/1.0, /*pos*/+2, /*pnl*/0.0);
+    Require(a == StrategyAction::None, "Strategy: expected BuyB blocked at +Y");
+    PrintOk("Strategy blocks BuyB at +Y");
+}
+
+void TestStrategyStopsOnStopLoss()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -10.0;
+
+    Strategy s(p);
+
+    StrategyAction a = s.Decide(/*sellEdge*/100.0, /*buyEdge*/100.0, /*pos*/0, /*pnl*/-11.0);
+    Require(a == StrategyAction::None, "Strategy: expected None when stop loss breached");
+    PrintOk("Strategy returns None when stop loss breached");
+}
+
+void TestSimulationEngine_SellBlocked_WhenBidSizeZero()
+{
+    StrategyParams p{};
+    p.MinArbitrageEdge = 1.0;
+    p.MaxAbsExposureLots = 2;
+    p.StopLossPnl = -50.0;
+
+    std::string tradeBuf;
+    tradeBuf.reserve(1 << 20); // 1MB,
+    SimulationEngine eng(Strategy(p), PnlTracker(), tradeBuf);
+
+    // Force SellB signal: B_bid - A_ask >= 1
+    eng.OnEvent(MakeQuote(100, InstrumentId::FutureA, 99.0, 100.0, 100, 100));
+    // B_bid=101, but bidSize=0 => should not sell
+    eng.OnEvent(MakeQuote(101, InstrumentId::FutureB, 101.0, 102.0, 0, 100));
+
+    Require(CountSubstr(tradeBuf, ",SELL,FutureB,1,") == 0, "Expected no SELL when bidSize is 0");
+    PrintOk("SimulationEngine blocks SellB when bidSize=0");
+}
+
+//================= CsvReader tests =================//
+
+void TestCsvReaderReadsFirstLine()
+{
+    CsvReader reader("Data/FutureA.csv");
+
+    MarketEvent ev{};
+    bool ok = reader.ReadNextEvent(ev);
+
+    Require(ok, "CsvReader: expected to read first line");
+    Require(ev.instrumentId == InstrumentId::FutureA, "CsvReader: expected instrumentId FutureA");
+    Require(ev.bidTicks > 0, "CsvReader: expected bid > 0");
+    Require(ev.askTicks >= ev.bidTicks, "CsvReader: expected ask >= bid");
+
+    PrintOk("CsvReader reads first line");
+}
+
+void TestCsvReaderEof()
+{
+    CsvReader reader("Data/FutureA.csv");
+
+    MarketEvent ev{};
+    int count = 0;
+
+    while (reader.ReadNextEvent(ev))
+        count++;
+
+    Require(count > 0, "CsvReader: expected at least one row");
+    PrintOk("CsvReader EOF handling");
+}
+
+void TestCsvReader_MemoryMappedMatchesStream()
+{
+    TempFile file("Data/_tmp_mapped_vs_stream.csv");
+
+    // CRLF, blank lines and no trailing newline on the last row
+    WriteTextFile(file.Path(),
+        "1000,FutureA,0,5,10.25,10.5,7\r\n"
+        "\n"
+        "1001,FutureB,1,6,20,20.75,8\n"
+        "1002,FutureA,0,1,11,11.5,2");
+
+    CsvReader stream(file.Path(), CsvReaderMode::Stream);
+    CsvReader mapped(file.Path(), CsvReaderMode::MemoryMapped);
+
+    MarketEvent a{}, b{};
+    int count = 0;
+    while (stream.ReadNextEvent(a))
+    {
+        Require(mapped.ReadNextEvent(b), "CsvReader: mapped reader ended early");
+        Require(a.sendingTime == b.sendingTime && a.instrumentId == b.instrumentId &&
+                a.eventTypeId == b.eventTypeId && a.bidSize == b.bidSize &&
+                a.bidTicks == b.bidTicks && a.askTicks == b.askTicks && a.askSize == b.askSize,
+                "CsvReader: mapped and stream events differ");
+        ++count;
+    }
+    Require(!mapped.ReadNextEvent(b), "CsvReader: mapped reader has extra rows");
+    Require(count == 3, "CsvReader: expected 3 rows");
+    Require(b.askSize == 2, "CsvReader: expected last row without newline to be parsed");
+
+    PrintOk("CsvReader memory-mapped mode matches stream mode");
+}
+
+void TestCsvReader_MemoryMappedErrorIncludesLine()
+{
+    TempFile file("Data/_tmp_mapped_error.csv");
+
+    // Empty askSize must not borrow the next line's timestamp
+    WriteTextFile(file.Path(),
+        "1000,FutureA,0,5,10.25,10.5,\n"
+        "1001,FutureA,0,5,10.25,10.5,7\n");
+
+    CsvReader reader(file.Path(), CsvReaderMode::MemoryMapped);
+    MarketEvent ev{};
+    std::string error;
+    try
+    {
+        reader.ReadNextEvent(ev);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    Require(error == "Parse error: askSize in 1000,FutureA,0,5,10.25,10.5,",
+        "CsvReader: unexpected error message: " + error);
+
+    PrintOk("CsvReader memory-mapped parse error reports the line");
+}
+
+void TestCsvScanner_AllKindsAgree()
+{
+    // Mixed content with lengths that are not multiples of the vector width
+    std::string text;
+    for (int i = 0; i < 300; ++i)
+    {
+        text += std::to_string(i * 7919) + ",FutureA,0," + std::string(static_cast<size_t>(i % 37), 'x') + "\n";
+        if (i % 5 == 0) text += ",,\r\n";
+    }
+
+    for (std::size_t len : { std::size_t(0), std::size_t(1), std::size_t(15), std::size_t(31), std::size_t(33), text.size() })
+    {
+        std::vector<uint32_t> expected(len + 1), actual(len + 1);
+        const char* b = text.data();
+        const std::size_t n = ScanStructural(ScannerKind::Scalar, b, b + len, expected.data());
+
+        std::size_t manual = 0;
+        for (std::size_t i = 0; i < len; ++i)
+            if (b[i] == ',' || b[i] == '\n') ++manual;
+        Require(n == manual, "CsvScanner: scalar count mismatch");
+
+        for (ScannerKind kind : { ScannerKind::Sse2, ScannerKind::Avx2 })
+        {
+            const std::size_t m = ScanStructural(kind, b, b + len, actual.data());
+            Require(m == n, std::string("CsvScanner: count mismatch for ") + ScannerKindName(kind));
+            for (std::size_t i = 0; i < n; ++i)
+                Require(actual[i] == expected[i], std::string("CsvScanner: offset mismatch for ") + ScannerKindName(kind));
+        }
+    }
+
+    PrintOk(std::string("CsvScanner kinds agree (active: ") + ScannerKindName(DetectScannerKind()) + ")");
+}
+
+void TestCsvReader_MemoryMappedAcrossScanBlocks()
+{
+    TempFile file("Data/_tmp_mapped_blocks.csv");
+
+    // ~300KB spans several 64KB scan blocks; one line is longer than a block
+    std::string content;
+    for (int i = 0; i < 6000; ++i)
+    {
+        content += std::to_string(1000 + i) + ",FutureB,0,1," + std::to_string(10 + i % 7) + ".25,20.5," +
+                   std::to_string(i % 9) + "\n";
+        if (i == 3000)
+            content += "5000," + std::string(100000, 'Z') + ",0,1,10,11,1\n";
+    }
+    WriteTextFile(file.Path(), content);
+
+    CsvReader stream(file.Path(), CsvReaderMode::Stream);
+    CsvReader mapped(file.Path(), CsvReaderMode::MemoryMapped);
+
+    MarketEvent a{}, b{};
+    int count = 0;
+    while (stream.ReadNextEvent(a))
+    {
+        Require(mapped.ReadNextEvent(b), "CsvReader: mapped reader ended early across blocks");
+        Require(a.sendingTime == b.sendingTime && a.instrumentId == b.instrumentId &&
+                a.bidTicks == b.bidTicks && a.askSize == b.askSize,
+                "CsvReader: mapped and stream events differ across blocks");
+        ++count;
+    }
+    Require(!mapped.ReadNextEvent(b), "CsvReader: mapped reader has extra rows across blocks");
+    Require(count == 6001, "CsvReader: expected 6001 rows across blocks");
+
+    PrintOk("CsvReader memory-mapped mode across scan blocks");
+}
+
+//================= BinaryEventFile tests =================//
+
+void TestBinaryEventFile_RoundTripMatchesCsv()
+{
+    TempFile binFile("Data/_tmp_roundtrip.bin");
+    {
+        CsvReader csv("Data/FutureA.csv");
+        BinaryEventWriter writer(binFile.Path());
+        MarketEvent ev{};
+        while (csv.ReadNextEvent(ev))
+            writer.Write(ev);
+        writer.Close();
+    }
+
+    Require(IsBinaryEventFile(binFile.Path()), "BinaryEventFile: magic not detected");
+    Require(!IsBinaryEventFile("Data/FutureA.csv"), "BinaryEventFile: CSV detected as binary");
+
+    CsvReader csv("Data/FutureA.csv");
+    std::unique_ptr<IEventSource> source = OpenEventSource(binFile.Path());
+    Require(dynamic_cast<BinaryEventReader*>(source.get()) != nullptr, "BinaryEventFile: factory did not pick binary reader");
+    const BinaryEventHeader header = static_cast<BinaryEventReader&>(*source).GetHeader();
+
+    MarketEvent a{}, b{};
+    std::uint64_t count = 0;
+    long long firstTime = 0;
+    while (csv.ReadNextEvent(a))
+    {
+        Require(source->ReadNextEvent(b), "BinaryEventFile: binary stream ended early");
+        Require(a.sendingTime == b.sendingTime && a.instrumentId == b.instrumentId &&
+                a.eventTypeId == b.eventTypeId && a.bidSize == b.bidSize &&
+                a.bidTicks == b.bidTicks && a.askTicks == b.askTicks && a.askSize == b.askSize,
+                "BinaryEventFile: event differs from CSV");
+        if (count == 0) firstTime = a.sendingTime;
+        ++count;
+    }
+    Require(!source->ReadNextEvent(b), "BinaryEventFile: binary stream has extra events");
+
+    Require(header.count == count, "BinaryEventFile: header count mismatch");
+    Require(header.firstTime == firstTime && header.lastTime == a.sendingTime, "BinaryEventFile: header time range mismatch");
+    Require(header.instrument == static_cast<uint8_t>(InstrumentId::FutureA), "BinaryEventFile: header instrument mismatch");
+
+    PrintOk("BinaryEventFile round trip matches CSV");
+}
+
+void TestBinaryEventFile_RejectsTruncatedFile()
+{
+    TempFile binFile("Data/_tmp_truncated.bin");
+    {
+        BinaryEventWriter writer(binFile.Path());
+        writer.Write(MakeQuote(1, InstrumentId::FutureB, 1.0, 2.0));
+        writer.Write(MakeQuote(2, InstrumentId::FutureB, 1.0, 2.0));
+    }
+
+    // Drop the last byte of the second record
+    std::string bytes;
+    {
+        std::ifstream in(binFile.Path(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bytes.pop_back();
+    WriteTextFile(binFile.Path(), bytes);
+
+    bool threw = false;
+    try
+    {
+        BinaryEventReader reader(binFile.Path());
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    Require(threw, "BinaryEventFile: expected truncated file to be rejected");
+    PrintOk("BinaryEventFile rejects truncated file");
+}
+
+static bool BinaryReaderThrows(const std::string& path)
+{
+    try
+    {
+        BinaryEventReader reader(path);
+        MarketEvent e{};
+        while (reader.ReadNextEvent(e)) {}
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+void TestBinaryEventFile_RejectsCorruptHeaderAndInstrument()
+{
+    TempFile binFile("Data/_tmp_corrupt.bin");
+    {
+        BinaryEventWriter writer(binFile.Path());
+        writer.Write(MakeQuote(1, InstrumentId::FutureA, 1.0, 2.0));
+        writer.Write(MakeQuote(2, InstrumentId::FutureA, 1.0, 2.0));
+    }
+    std::string bytes;
+    {
+        std::ifstream in(binFile.Path(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // count * recordSize wraps around to the real payload size
+    std::string wrapped = bytes;
+    const uint64_t wrappingCount = 2 + (uint64_t(1) << 61);
+    std::memcpy(&wrapped[offsetof(BinaryEventHeader, count)], &wrappingCount, sizeof(wrappingCount));
+    WriteTextFile(binFile.Path(), wrapped);
+    Require(BinaryReaderThrows(binFile.Path()), "BinaryEventFile: expected wrapping record count to be rejected");
+
+    // Instrument byte past InstrumentId::Unknown in the second record
+    std::string badInstrument = bytes;
+    badInstrument[sizeof(BinaryEventHeader) + sizeof(BinaryEventRecord) + offsetof(BinaryEventRecord, instrument)] = 7;
+    WriteTextFile(binFile.Path(), badInstrument);
+    Require(BinaryReaderThrows(binFile.Path()), "BinaryEventFile: expected invalid instrument to be rejected");
+
+    PrintOk("BinaryEventFile rejects corrupt count and instrument");
+}
+
+//================= Compressed input tests =================//
+
+#ifdef ARBSIM_HAVE_ZLIB
+// Writes content as gzip, split into two concatenated members
+void WriteGzipFile(const std::string& path, const std::string& content)
+{
+    const size_t half = content.size() / 2;
+    const char* modes[] = { "wb", "ab" };
+    const size_t begins[] = { 0, half };
+    const size_t ends[] = { half, content.size() };
+    for (int m = 0; m < 2; ++m)
+    {
+        gzFile gz = gzopen(path.c_str(), modes[m]);
+        Require(gz != nullptr, "Failed to open gzip file: " + path);
+        const unsigned len = static_cast<unsigned>(ends[m] - begins[m]);
+        Require(gzwrite(gz, content.data() + begins[m], len) == static_cast<int>(len), "gzwrite failed");
+        gzclose(gz);
+    }
+}
+
+void TestCsvReader_GzipMatchesPlain()
+{
+    std::string data;
+    {
+        std::ifstream in("Data/FutureA.csv", std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    Require(!data.empty(), "Gzip: expected Data/FutureA.csv");
+    // Spans several decompressed chunks, so lines are cut at chunk ends
+    std::string content;
+    while (content.size() < 2 * DecompressingStream::kChunkBytes + 12345)
+    {
+        content += data;
+    }
+
+    TempFile plain("Data/_tmp_gzip_plain.csv");
+    TempFile gz("Data/_tmp_gzip.csv.gz");
+    WriteTextFile(plain.Path(), content);
+    WriteGzipFile(gz.Path(), content);
+
+    Require(DetectCompression(gz.Path()) == Compression::Gzip, "Gzip: magic not detected");
+    Require(DetectCompression(plain.Path()) == Compression::None, "Gzip: plain file detected as compressed");
+
+    CsvReader direct(plain.Path());
+    std::unique_ptr<IEventSource> compressed = OpenEventSource(gz.Path());
+
+    MarketEvent a{}, b{};
+    size_t count = 0;
+    while (direct.ReadNextEvent(a))
+    {
+        Require(compressed->ReadNextEvent(b), "Gzip: stream ended early");
+        Require(a.sendingTime == b.sendingTime && a.instrumentId == b.instrumentId &&
+                a.bidTicks == b.bidTicks && a.askTicks == b.askTicks &&
+                a.bidSize == b.bidSize && a.askSize == b.askSize,
+                "Gzip: event differs from plain reader");
+        ++count;
+    }
+    Require(!compressed->ReadNextEvent(b), "Gzip: extra events");
+    Require(count > 0, "Gzip: expected events");
+
+    PrintOk("CsvReader gzip input matches plain CSV");
+}
+
+void TestCsvReader_GzipTruncatedThrows()
+{
+    std::string content;
+    for (int i = 0; i < 100000; ++i)
+    {
+        content += std::to_string(1000 + i) + ",FutureA,0,1,10.5,11.25,1\n";
+    }
+
+    TempFile gz("Data/_tmp_gzip_truncated.csv.gz");
+    WriteGzipFile(gz.Path(), content);
+
+    std::string bytes;
+    {
+        std::ifstream in(gz.Path(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bytes.resize(bytes.size() - 16);
+    WriteTextFile(gz.Path(), bytes);
+
+    CsvReader reader(gz.Path(), CsvReaderMode::Compressed);
+    MarketEvent ev{};
+    size_t count = 0;
+    std::string error;
+    try
+    {
+        while (reader.ReadNextEvent(ev))
+        {
+            Require(ev.sendingTime == static_cast<long long>(1000 + count), "Gzip: events out of order");
+            ++count;
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    Require(error.find("truncated") != std::string::npos, "Gzip: expected truncation error, got: " + error);
+    Require(count > 0, "Gzip: expected events before the error");
+
+    PrintOk("CsvReader gzip truncated input throws after preceding events");
+}
+#endif
+
+//================= Time-range replay tests =================//
+
+std::vector<MarketEvent> ReadAllEvents(IEventSource& source)
+{
+    std::vector<MarketEvent> events;
+    MarketEvent ev{};
+    while (source.ReadNextEvent(ev))
+        events.push_back(ev);
+    return events;
+}
+
+void TestTimeIndex_SeekMatchesFullScan()
+{
+    TempFile csv("Data/_tmp_seek.csv");
+    TempFile idx(TimeIndex::SidecarPath(csv.Path()));
+    TempFile bin("Data/_tmp_seek.bin");
+    {
+        std::ifstream in("Data/FutureA.csv", std::ios::binary);
+        WriteTextFile(csv.Path(), std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+    }
+
+    std::vector<MarketEvent> all;
+    {
+        CsvReader reader(csv.Path());
+        all = ReadAllEvents(reader);
+        BinaryEventWriter writer(bin.Path());
+        for (const MarketEvent& ev : all)
+            writer.Write(ev);
+    }
+    Require(all.size() > 2 * TimeIndex::kDefaultStride, "Seek: expected several index samples");
+
+    // Before the file, on index samples (where duplicates straddle the
+    // sample), between samples, and after the file
+    std::vector<long long> starts = { all.front().sendingTime - 1, all.front().sendingTime };
+    for (size_t i : { TimeIndex::kDefaultStride, TimeIndex::kDefaultStride + 1, all.size() / 2, all.size() - 1 })
+        starts.push_back(all[i].sendingTime);
+    starts.push_back(all.back().sendingTime + 1);
+
+    for (long long start : starts)
+    {
+        std::vector<MarketEvent> expected;
+        for (const MarketEvent& ev : all)
+            if (ev.sendingTime >= start)
+                expected.push_back(ev);
+
+        CsvReader mapped(csv.Path());
+        CsvReader stream(csv.Path(), CsvReaderMode::Stream);
+        BinaryEventReader binary(bin.Path());
+        IEventSource* sources[] = { &mapped, &stream, &binary };
+        for (IEventSource* source : sources)
+        {
+            Require(source->SeekToTime(start), "Seek: expected seek support");
+            std::vector<MarketEvent> got;
+            for (const MarketEvent& ev : ReadAllEvents(*source))
+                if (ev.sendingTime >= start)
+                    got.push_back(ev);
+            Require(got.size() == expected.size(), "Seek: wrong number of events from " + std::to_string(start));
+            for (size_t i = 0; i < got.size(); ++i)
+                Require(got[i].sendingTime == expected[i].sendingTime && got[i].bidTicks == expected[i].bidTicks &&
+                        got[i].askTicks == expected[i].askTicks && got[i].bidSize == expected[i].bidSize,
+                        "Seek: event differs from full scan");
+        }
+    }
 
-    Require(CountSubstr(tradeBuf, "EOD_CLOSE") == 1, "SimEngine: expected EOD_CLOSE tag");
-    PrintOk("SimulationEngine end-of-day close tagged");
+    PrintOk("TimeIndex seek matches full scan (mapped, stream, binary)");
 }
 
-//================= Strategy tests (new Decide signature) =================//
+void TestTimeIndex_RebuildsStaleSidecar()
+{
+    TempFile csv("Data/_tmp_index.csv");
+    TempFile idx(TimeIndex::SidecarPath(csv.Path()));
+    std::string content;
+    for (int i = 0; i < 100; ++i)
+        content += std::to_string(1000 + i) + ",FutureA,0,1,10,11,1\n";
+    WriteTextFile(csv.Path(), content);
+
+    TimeIndex built = TimeIndex::LoadOrBuild(csv.Path(), 10);
+    Require(!built.WasLoaded(), "TimeIndex: first use should build");
+    Require(built.GetEntries().size() == 10, "TimeIndex: expected one sample per 10 rows");
+    Require(built.FindOffset(1000) == 0, "TimeIndex: offset before first sample");
+    Require(built.FindOffset(1025) == built.GetEntries()[2].offset, "TimeIndex: offset of last earlier sample");
+
+    TimeIndex loaded = TimeIndex::LoadOrBuild(csv.Path(), 10);
+    Require(loaded.WasLoaded(), "TimeIndex: second use should load the sidecar");
+    Require(loaded.GetEntries().size() == built.GetEntries().size(), "TimeIndex: loaded index differs");
+
+    // A different stride or a modified CSV invalidates the sidecar
+    Require(!TimeIndex::LoadOrBuild(csv.Path(), 20).WasLoaded(), "TimeIndex: stride change should rebuild");
+    WriteTextFile(csv.Path(), content + "2000,FutureA,0,1,10,11,1\n");
+    TimeIndex rebuilt = TimeIndex::LoadOrBuild(csv.Path(), 20);
+    Require(!rebuilt.WasLoaded(), "TimeIndex: modified CSV should rebuild");
+    Require(rebuilt.GetEntries().size() == 6, "TimeIndex: rebuilt index should cover the new row");
+
+    PrintOk("TimeIndex rebuilds a stale sidecar");
+}
 
-void TestStrategyReturnsNone_WhenEdgesSmall()
+void TestTimeIndex_RebuildsCorruptCount()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 2.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    TempFile csv("Data/_tmp_index_count.csv");
+    TempFile idx(TimeIndex::SidecarPath(csv.Path()));
+    std::string content;
+    for (int i = 0; i < 100; ++i)
+        content += std::to_string(1000 + i) + ",FutureA,0,1,10,11,1\n";
+    WriteTextFile(csv.Path(), content);
+    const TimeIndex built = TimeIndex::LoadOrBuild(csv.Path(), 10);
+
+    std::string bytes;
+    {
+        std::ifstream in(idx.Path(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
 
-    Strategy s(p);
+    // The count is the last field of the 40-byte header; count * 16 wraps
+    // around to the real payload size
+    const size_t countOffset = 32;
+    const uint64_t wrappingCount = built.GetEntries().size() + (uint64_t(1) << 60);
+    std::memcpy(&bytes[countOffset], &wrappingCount, sizeof(wrappingCount));
+    WriteTextFile(idx.Path(), bytes);
 
-    StrategyAction a = s.Decide(/*sellEdge*/1.999, /*buyEdge*/1.999, /*pos*/0, /*pnl*/0.0);
-    Require(a == StrategyAction::None, "Strategy: expected None when edges are below threshold");
-    PrintOk("Strategy returns None when edges small");
+    const TimeIndex rebuilt = TimeIndex::LoadOrBuild(csv.Path(), 10);
+    Require(!rebuilt.WasLoaded(), "TimeIndex: wrapping entry count should rebuild");
+    Require(rebuilt.GetEntries().size() == built.GetEntries().size(), "TimeIndex: rebuilt index differs");
+
+    PrintOk("TimeIndex rebuilds a sidecar with a corrupt count");
 }
 
-void TestStrategySells_WhenSellEdgeBig()
+void TestStreamMerger_TimeWindow()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 2.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    std::vector<MarketEvent> a, b;
+    {
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        a = ReadAllEvents(readerA);
+        b = ReadAllEvents(readerB);
+    }
+    const long long start = a[a.size() / 3].sendingTime;
+    const long long end = a[a.size() / 2].sendingTime;
 
-    Strategy s(p);
+    size_t expected = 0;
+    for (const auto* events : { &a, &b })
+        for (const MarketEvent& ev : *events)
+            expected += (ev.sendingTime >= start && ev.sendingTime < end) ? 1 : 0;
 
-    StrategyAction a = s.Decide(/*sellEdge*/2.0, /*buyEdge*/0.0, /*pos*/0, /*pnl*/0.0);
-    Require(a == StrategyAction::SellB, "Strategy: expected SellB when sellEdge big");
-    PrintOk("Strategy sells when sellEdge big");
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    readerA.SeekToTime(start);
+    readerB.SeekToTime(start);
+    StreamMerger merger(readerA, readerB);
+    merger.SetTimeWindow(start, end);
+
+    MarketEvent ev{};
+    size_t count = 0;
+    long long prev = start;
+    while (merger.ReadNext(ev))
+    {
+        Require(ev.sendingTime >= start && ev.sendingTime < end, "TimeWindow: event outside [start, end)");
+        Require(ev.sendingTime >= prev, "TimeWindow: events out of order");
+        prev = ev.sendingTime;
+        ++count;
+    }
+    Require(count == expected && count > 0, "TimeWindow: expected " + std::to_string(expected) + " events, got " + std::to_string(count));
+
+    std::remove(TimeIndex::SidecarPath("Data/FutureA.csv").c_str());
+    std::remove(TimeIndex::SidecarPath("Data/FutureB.csv").c_str());
+    PrintOk("StreamMerger time window returns exactly [start, end)");
 }
 
-void TestStrategyBuys_WhenBuyEdgeBig()
+//================= ParallelCsvReader tests =================//
+
+void TestTimelineCache_ReplaysMergedTimeline()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 2.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    const std::string cacheDir = "Data/_tmp_timeline_cache";
+    std::filesystem::remove_all(cacheDir);
 
-    Strategy s(p);
+    std::vector<MarketEvent> merged;
+    {
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        StreamMerger merger(readerA, readerB, 7);
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+            merged.push_back(ev);
+    }
 
-    StrategyAction a = s.Decide(/*sellEdge*/0.0, /*buyEdge*/2.0, /*pos*/0, /*pnl*/0.0);
-    Require(a == StrategyAction::BuyB, "Strategy: expected BuyB when buyEdge big");
-    PrintOk("Strategy buys when buyEdge big");
+    bool built = false;
+    std::unique_ptr<IEventSource> first = TimelineCache::Open(cacheDir, "Data/FutureA.csv", "Data/FutureB.csv", 7, nullptr, &built);
+    Require(built, "TimelineCache: first open did not build the cache");
+    const std::vector<MarketEvent> replayed = ReadAllEvents(*first);
+    Require(replayed.size() == merged.size(), "TimelineCache: event count differs from StreamMerger");
+    for (size_t i = 0; i < merged.size(); ++i)
+    {
+        Require(replayed[i].sendingTime == merged[i].sendingTime && replayed[i].instrumentId == merged[i].instrumentId &&
+                replayed[i].bidTicks == merged[i].bidTicks && replayed[i].askTicks == merged[i].askTicks &&
+                replayed[i].bidSize == merged[i].bidSize && replayed[i].askSize == merged[i].askSize,
+                "TimelineCache: replay differs from StreamMerger");
+    }
+
+    // A window cut from the cached timeline, as the replay reads it
+    {
+        const long long startTime = merged[merged.size() / 3].sendingTime;
+        const long long endTime = merged[2 * merged.size() / 3].sendingTime;
+        std::vector<MarketEvent> expected;
+        for (const MarketEvent& e : merged)
+            if (e.sendingTime >= startTime && e.sendingTime < endTime)
+                expected.push_back(e);
+
+        std::unique_ptr<IEventSource> cached = TimelineCache::Open(cacheDir, "Data/FutureA.csv", "Data/FutureB.csv", 7);
+        cached->SeekToTime(startTime);
+        TimeWindowEventSource window(std::move(cached), startTime, endTime);
+        std::vector<MarketEvent> windowed;
+        std::vector<MarketEvent> block(1000);
+        size_t n = 0;
+        while ((n = window.ReadEvents(block.data(), block.size())) > 0)
+            windowed.insert(windowed.end(), block.begin(), block.begin() + n);
+        Require(windowed.size() == expected.size(), "TimelineCache: windowed replay event count differs");
+        for (size_t i = 0; i < expected.size(); ++i)
+            Require(windowed[i].sendingTime == expected[i].sendingTime && windowed[i].instrumentId == expected[i].instrumentId,
+                    "TimelineCache: windowed replay differs from the merged window");
+    }
+
+    // Same inputs and seed: hit; another seed: separate cache
+    TimelineCache::Open(cacheDir, "Data/FutureA.csv", "Data/FutureB.csv", 7, nullptr, &built);
+    Require(!built, "TimelineCache: second open rebuilt the cache");
+    TimelineCache::Open(cacheDir, "Data/FutureA.csv", "Data/FutureB.csv", 8, nullptr, &built);
+    Require(built, "TimelineCache: seed is not part of the key");
+
+    // Key follows file contents, not names
+    const std::string copyA = cacheDir + "/FutureA_copy.csv";
+    std::filesystem::copy_file("Data/FutureA.csv", copyA);
+    TimelineCache::Open(cacheDir, copyA, "Data/FutureB.csv", 7, nullptr, &built);
+    Require(!built, "TimelineCache: identical contents under another name missed the cache");
+    {
+        std::ofstream f(copyA, std::ios::binary | std::ios::app);
+        f << "1999999999999999999,FutureA,1,1,100,101,1\n";
+    }
+    TimelineCache::Open(cacheDir, copyA, "Data/FutureB.csv", 7, nullptr, &built);
+    Require(built, "TimelineCache: changed input did not rebuild the cache");
+
+    first.reset();
+    std::filesystem::remove_all(cacheDir);
+    PrintOk("TimelineCache replays the merged timeline and keys on contents and seed");
 }
 
-void TestStrategyExposure_PostTrade_AllowsSellFromPlusY()
+void TestParallelCsvReader_MatchesSerial()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 1.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    ThreadPool pool(4);
+    CsvReader serial("Data/FutureA.csv");
+    const std::vector<MarketEvent> expected = ReadAllEvents(serial);
 
-    Strategy s(p);
+    // Tiny chunks (down to one line each) exercise the newline splitting
+    for (size_t chunkBytes : { size_t(1), size_t(1000), ParallelCsvReader::kDefaultChunkBytes })
+    {
+        ParallelCsvReader parallel("Data/FutureA.csv", pool, chunkBytes);
+        const std::vector<MarketEvent> got = ReadAllEvents(parallel);
+        Require(got.size() == expected.size(), "ParallelCsvReader: wrong event count");
+        for (size_t i = 0; i < got.size(); ++i)
+            Require(got[i].sendingTime == expected[i].sendingTime && got[i].bidTicks == expected[i].bidTicks &&
+                    got[i].askTicks == expected[i].askTicks && got[i].bidSize == expected[i].bidSize &&
+                    got[i].askSize == expected[i].askSize && got[i].instrumentId == expected[i].instrumentId,
+                    "ParallelCsvReader: event differs from serial reader");
+    }
 
-    // pos=+2, SellB would go to +1 which is allowed
-    StrategyAction a = s.Decide(/*sellEdge*/1.0, /*buyEdge*/0.0, /*pos*/+2, /*pnl*/0.0);
-    Require(a == StrategyAction::SellB, "Strategy: expected SellB allowed from +Y");
-    PrintOk("Strategy allows SellB from +Y");
+    PrintOk("ParallelCsvReader matches serial reader");
 }
 
-void TestStrategyExposure_PostTrade_BlocksBuyAtPlusY()
+void TestParallelCsvReader_ErrorAfterPrecedingEvents()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 1.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    TempFile file("Data/_tmp_parallel_error.csv");
+    std::string content;
+    for (int i = 0; i < 1000; ++i)
+        content += (i == 600) ? "1600,FutureA,0,1,10.5,oops,1\n"
+                              : std::to_string(1000 + i) + ",FutureA,0,1,10.5,11,1\n";
+    WriteTextFile(file.Path(), content);
+
+    std::string serialError;
+    try
+    {
+        CsvReader serial(file.Path());
+        ReadAllEvents(serial);
+    }
+    catch (const std::runtime_error& e)
+    {
+        serialError = e.what();
+    }
+    Require(!serialError.empty(), "ParallelCsvReader: expected the serial reader to fail");
 
-    Strategy s(p);
+    ThreadPool pool(4);
+    ParallelCsvReader parallel(file.Path(), pool, 256);
+    MarketEvent ev{};
+    long long count = 0;
+    std::string error;
+    try
+    {
+        while (parallel.ReadNextEvent(ev))
+        {
+            Require(ev.sendingTime == 1000 + count, "ParallelCsvReader: events out of order");
+            ++count;
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    Require(count == 600, "ParallelCsvReader: expected 600 events before the error, got " + std::to_string(count));
+    Require(error == serialError, "ParallelCsvReader: error differs from serial reader: " + error);
 
-    // pos=+2, BuyB would go to +3 which is blocked
-    StrategyAction a = s.Decide(/*sellEdge*/0.0, /*buyEdge*/1.0, /*pos*/+2, /*pnl*/0.0);
-    Require(a == StrategyAction::None, "Strategy: expected BuyB blocked at +Y");
-    PrintOk("Strategy blocks BuyB at +Y");
+    PrintOk("ParallelCsvReader rethrows the serial error after preceding events");
 }
 
-void TestStrategyStopsOnStopLoss()
+//================= PrefetchingEventSource tests =================//
+
+void TestPrefetchingEventSource_MatchesDirectReader()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 1.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -10.0;
+    CsvReader direct("Data/FutureB.csv");
+    // Tiny batches and ring to exercise wrap-around and stalls on both sides
+    PrefetchingEventSource prefetch(std::make_unique<CsvReader>("Data/FutureB.csv"), 7, 2);
 
-    Strategy s(p);
+    MarketEvent a{}, b{};
+    int count = 0;
+    while (direct.ReadNextEvent(a))
+    {
+        Require(prefetch.ReadNextEvent(b), "Prefetch: stream ended early");
+        Require(a.sendingTime == b.sendingTime && a.bidTicks == b.bidTicks && a.askTicks == b.askTicks &&
+                a.bidSize == b.bidSize && a.askSize == b.askSize,
+                "Prefetch: event differs from direct reader");
+        ++count;
+    }
+    Require(!prefetch.ReadNextEvent(b), "Prefetch: extra events");
+    Require(!prefetch.ReadNextEvent(b), "Prefetch: expected EOF to be sticky");
+    Require(count > 0, "Prefetch: expected events");
 
-    StrategyAction a = s.Decide(/*sellEdge*/100.0, /*buyEdge*/100.0, /*pos*/0, /*pnl*/-11.0);
-    Require(a == StrategyAction::None, "Strategy: expected None when stop loss breached");
-    PrintOk("Strategy returns None when stop loss breached");
+    PrintOk("PrefetchingEventSource matches direct reader");
 }
 
-void TestSimulationEngine_SellBlocked_WhenBidSizeZero()
+void TestPrefetchingEventSource_RethrowsAfterPrecedingEvents()
 {
-    StrategyParams p{};
-    p.MinArbitrageEdge = 1.0;
-    p.MaxAbsExposureLots = 2;
-    p.StopLossPnl = -50.0;
+    TempFile file("Data/_tmp_prefetch_error.csv");
+    WriteTextFile(file.Path(),
+        "1000,FutureA,0,1,10,11,1\n"
+        "1001,FutureA,0,1,10,11,1\n"
+        "1002,FutureA,0,1,10,11\n"
+        "1003,FutureA,0,1,10,11,1\n");
 
-    std::string tradeBuf;
-    tradeBuf.reserve(1 << 20); // 1MB,
-    SimulationEngine eng(Strategy(p), PnlTracker(), tradeBuf);
+    PrefetchingEventSource prefetch(std::make_unique<CsvReader>(file.Path()), 4, 2);
 
-    // Force SellB signal: B_bid - A_ask >= 1
-    eng.OnEvent(MakeQuote(100, InstrumentId::FutureA, 99.0, 100.0, 100, 100));
-    // B_bid=101, but bidSize=0 => should not sell
-    eng.OnEvent(MakeQuote(101, InstrumentId::FutureB, 101.0, 102.0, 0, 100));
+    MarketEvent ev{};
+    Require(prefetch.ReadNextEvent(ev) && ev.sendingTime == 1000, "Prefetch: expected first event");
+    Require(prefetch.ReadNextEvent(ev) && ev.sendingTime == 1001, "Prefetch: expected second event");
 
-    Require(CountSubstr(tradeBuf, ",SELL,FutureB,1,") == 0, "Expected no SELL when bidSize is 0");
-    PrintOk("SimulationEngine blocks SellB when bidSize=0");
-}
+    std::string error;
+    try
+    {
+        prefetch.ReadNextEvent(ev);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    Require(error.find("1002,FutureA,0,1,10,11") != std::string::npos, "Prefetch: expected parse error with line, got: " + error);
 
-//================= CsvReader tests =================//
+    PrintOk("PrefetchingEventSource rethrows reader errors in order");
+}
 
-void TestCsvReaderReadsFirstLine()
+void TestPrefetchingEventSource_EarlyDestruction()
 {
-    CsvReader reader("Data/FutureA.csv");
-
+    // Consumer stops after one event; destructor must not hang on a full ring
+    PrefetchingEventSource prefetch(std::make_unique<CsvReader>("Data/FutureA.csv"), 1, 1);
     MarketEvent ev{};
-    bool ok = reader.ReadNextEvent(ev);
+    Require(prefetch.ReadNextEvent(ev), "Prefetch: expected one event");
 
-    Require(ok, "CsvReader: expected to read first line");
-    Require(ev.instrumentId == InstrumentId::FutureA, "CsvReader: expected instrumentId FutureA");
-    Require(ev.bid > 0.0, "CsvReader: expected bid > 0");
-    Require(ev.ask >= ev.bid, "CsvReader: expected ask >= bid");
-
-    PrintOk("CsvReader reads first line");
+    PrintOk("PrefetchingEventSource early destruction");
 }
 
-void TestCsvReaderEof()
+//================= PriceParser tests =================//
+
+static void RequirePriceMatchesStrtod(const std::string& text)
 {
-    CsvReader reader("Data/FutureA.csv");
+    char* strtodEnd = nullptr;
+    const double expectedValue = std::strtod(text.c_str(), &strtodEnd);
+    const long long expectedScaled = std::llround(expectedValue * static_cast<double>(kPnlMultiplier));
+
+    double value = 0.0;
+    int64_t scaled = 0;
+    const char* next = ParsePrice(text.data(), text.data() + text.size(), scaled, value);
+
+    Require(next != nullptr, "PriceParser: failed to parse " + text);
+    Require(next == text.data() + (strtodEnd - text.c_str()), "PriceParser: consumed length differs for " + text);
+    Require(std::memcmp(&value, &expectedValue, sizeof(double)) == 0, "PriceParser: double differs from strtod for " + text);
+    Require(scaled == expectedScaled, "PriceParser: scaled differs from ToInt(strtod) for " + text);
+
+    int64_t ticks = 0;
+    Require(ParsePriceTicks(text.data(), text.data() + text.size(), ticks) == next, "PriceParser: ParsePriceTicks consumed length differs for " + text);
+    Require(ticks == expectedScaled && ticks == PriceToTicks(expectedValue), "PriceParser: ticks differ from PriceToTicks(strtod) for " + text);
+}
 
-    MarketEvent ev{};
-    int count = 0;
+void TestPriceParser_BitExactWithStrtod()
+{
+    const char* fixed[] = {
+        "0", "-0", "10928.5", "10928.25", "0.000001", "0.0000005", "-0.0000015", "1.0000005",
+        "+5.5", ".5", "5.", "1e3", "2.5e-7", "123456789012.123456", "2251799813.685247",
+        "2251799813.685248", "9007199254.740993", "99999999999999999999", "0.1", "0.7", "1.005",
+        "4503599627370495.5", "12.345678901234567890"
+    };
+    for (const char* t : fixed)
+        RequirePriceMatchesStrtod(t);
+
+    // Random decimals: 0-9 fraction digits over a wide range of magnitudes
+    std::mt19937_64 rng(12345);
+    char buf[64];
+    for (int i = 0; i < 200000; ++i)
+    {
+        const int intDigits = static_cast<int>(rng() % 13);
+        const int fracDigits = static_cast<int>(rng() % 10);
+        int n = 0;
+        if (rng() % 4 == 0) buf[n++] = '-';
+        for (int d = 0; d < intDigits; ++d) buf[n++] = static_cast<char>('0' + rng() % 10);
+        if (intDigits == 0) buf[n++] = '0';
+        if (fracDigits > 0)
+        {
+            buf[n++] = '.';
+            for (int d = 0; d < fracDigits; ++d) buf[n++] = static_cast<char>('0' + rng() % 10);
+        }
+        RequirePriceMatchesStrtod(std::string(buf, static_cast<std::size_t>(n)));
+    }
 
-    while (reader.ReadNextEvent(ev))
-        count++;
+    // Every bid/ask in the market data files
+    for (const char* path : { "Data/FutureA.csv", "Data/FutureB.csv" })
+    {
+        std::ifstream f(path);
+        std::string line;
+        while (std::getline(f, line))
+        {
+            std::stringstream fields(line);
+            std::string field;
+            for (int k = 0; std::getline(fields, field, ','); ++k)
+                if (k == 4 || k == 5)
+                    RequirePriceMatchesStrtod(field);
+        }
+    }
 
-    Require(count > 0, "CsvReader: expected at least one row");
-    PrintOk("CsvReader EOF handling");
+    PrintOk("PriceParser bit-exact with strtod / ToInt(strtod)");
 }
 
 //================= StreamMerger tests =================//
@@ -426,6 +2053,48 @@ void TestStreamMergerTieBreak_AFirstOnEqualTimestamp()
     // Files auto-deleted when TempFile objects go out of scope
 }
 
+void TestStreamMerger_WindowMergesLikeFullDay()
+{
+    std::vector<MarketEvent> full;
+    {
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        StreamMerger merger(readerA, readerB, 7);
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+            full.push_back(ev);
+    }
+
+    // Windows start on a timestamp boundary; ties inside them must be broken
+    // exactly as in the full-day merge
+    for (size_t from : { full.size() / 4, full.size() / 2 })
+    {
+        const long long start = full[from].sendingTime;
+        const long long end = full[from + full.size() / 8].sendingTime;
+
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        StreamMerger merger(readerA, readerB, 7);
+        merger.SetTimeWindow(start, end);
+
+        size_t i = 0;
+        while (i < full.size() && full[i].sendingTime < start)
+            ++i;
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+        {
+            Require(i < full.size() && full[i].sendingTime < end, "TieBreak: window produced extra events");
+            Require(ev.sendingTime == full[i].sendingTime && ev.instrumentId == full[i].instrumentId &&
+                    ev.bidTicks == full[i].bidTicks && ev.bidSize == full[i].bidSize,
+                    "TieBreak: window order differs from full-day merge");
+            ++i;
+        }
+        Require(i == full.size() || full[i].sendingTime >= end, "TieBreak: window ended early");
+    }
+
+    PrintOk("StreamMerger windows merge exactly like the full day");
+}
+
 void TestStreamMergerOrdering()
 {
     CsvReader readerA("Data/FutureA.csv");
@@ -452,6 +2121,226 @@ void TestStreamMergerOrdering()
     PrintOk("StreamMerger keeps chronological order");
 }
 
+void TestStreamMerger_ReadBatchMatchesReadNext()
+{
+    std::vector<MarketEvent> expected;
+    {
+        CsvReader readerA("Data/FutureA.csv");
+        CsvReader readerB("Data/FutureB.csv");
+        StreamMerger merger(readerA, readerB);
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+            expected.push_back(ev);
+    }
+
+    // Irregular batch sizes, mixed with single reads
+    CsvReader readerA("Data/FutureA.csv");
+    CsvReader readerB("Data/FutureB.csv");
+    StreamMerger merger(readerA, readerB);
+    std::vector<MarketEvent> got;
+    std::vector<MarketEvent> batch(5000);
+    const size_t sizes[] = { 1, 7, 1024, 4096, 5000, 3 };
+    for (size_t i = 0;; ++i)
+    {
+        const size_t n = merger.ReadBatch(batch.data(), sizes[i % 6]);
+        if (n == 0)
+            break;
+        got.insert(got.end(), batch.begin(), batch.begin() + n);
+        MarketEvent ev{};
+        if (merger.ReadNext(ev))
+            got.push_back(ev);
+    }
+
+    Require(got.size() == expected.size(), "StreamMerger: ReadBatch event count differs");
+    for (size_t i = 0; i < got.size(); ++i)
+        Require(got[i].sendingTime == expected[i].sendingTime && got[i].instrumentId == expected[i].instrumentId &&
+                got[i].bidTicks == expected[i].bidTicks && got[i].bidSize == expected[i].bidSize,
+                "StreamMerger: ReadBatch order differs from ReadNext");
+
+    PrintOk("StreamMerger ReadBatch matches ReadNext");
+}
+
+void TestCsvReader_ReadEventsDefersErrorAfterEvents()
+{
+    TempFile file("Data/_tmp_read_events_error.csv");
+    WriteTextFile(file.Path(),
+        "1000,FutureA,0,1,10,11,1\n"
+        "1001,FutureA,0,1,10,11,1\n"
+        "1002,FutureA,0,1,10\n");
+
+    CsvReader reader(file.Path());
+    MarketEvent out[8];
+    Require(reader.ReadEvents(out, 8) == 2, "ReadEvents: expected the two good events first");
+    Require(out[1].sendingTime == 1001, "ReadEvents: wrong second event");
+
+    std::string error;
+    try
+    {
+        reader.ReadEvents(out, 8);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    Require(error.find("1002,FutureA,0,1,10") != std::string::npos, "ReadEvents: expected error with line, got: " + error);
+    PrintOk("CsvReader ReadEvents returns events before an error");
+}
+
+// In-memory source for merger tests
+class VectorEventSource : public IEventSource {
+public:
+    explicit VectorEventSource(std::vector<MarketEvent> events) : events_(std::move(events)) {}
+
+    const std::string& GetFilePath() const override { return name_; }
+
+    bool ReadNextEvent(MarketEvent& event) override
+    {
+        if (pos_ == events_.size())
+            return false;
+        event = events_[pos_++];
+        return true;
+    }
+
+private:
+    std::vector<MarketEvent> events_;
+    size_t pos_ = 0;
+    std::string name_ = "vector";
+};
+
+void TestKWayMerger_TwoSourcesMatchStreamMerger()
+{
+    for (unsigned seed : { 42u, 7u, 12345u })
+    {
+        CsvReader a1("Data/FutureA.csv"), b1("Data/FutureB.csv");
+        CsvReader a2("Data/FutureA.csv"), b2("Data/FutureB.csv");
+        StreamMerger pairwise(a1, b1, seed);
+        KWayMerger kway({ &a2, &b2 }, seed);
+
+        MarketEvent x{}, y{};
+        size_t count = 0;
+        while (pairwise.ReadNext(x))
+        {
+            Require(kway.ReadNext(y), "KWayMerger: stream ended early");
+            Require(x.sendingTime == y.sendingTime && x.instrumentId == y.instrumentId && x.bidTicks == y.bidTicks &&
+                    x.bidSize == y.bidSize, "KWayMerger: differs from StreamMerger at event " + std::to_string(count));
+            ++count;
+        }
+        Require(!kway.ReadNext(y), "KWayMerger: extra events");
+    }
+    PrintOk("KWayMerger with two sources matches StreamMerger");
+}
+
+void TestKWayMerger_ManySourcesSortedAndComplete()
+{
+    // 13 sources (not a power of two), heavy timestamp collisions, some empty
+    const size_t k = 13;
+    std::mt19937 rng(3);
+    std::vector<std::vector<MarketEvent>> streams(k);
+    size_t total = 0;
+    for (size_t s = 0; s < k; ++s)
+    {
+        if (s % 5 == 4)
+            continue;
+        long long t = 1000;
+        for (int i = 0; i < 3000; ++i)
+        {
+            t += static_cast<long long>(rng() % 3);
+            MarketEvent ev = MakeQuote(t, InstrumentId::FutureA, static_cast<double>(s), static_cast<double>(i));
+            streams[s].push_back(ev);
+            ++total;
+        }
+    }
+
+    std::vector<std::unique_ptr<VectorEventSource>> owned;
+    std::vector<IEventSource*> sources;
+    for (auto& stream : streams)
+    {
+        owned.push_back(std::make_unique<VectorEventSource>(stream));
+        sources.push_back(owned.back().get());
+    }
+
+    KWayMerger merger(sources);
+    std::vector<MarketEvent> batch(777);
+    std::vector<int> nextPerSource(k, 0);
+    size_t count = 0;
+    long long prev = 0;
+    size_t n = 0;
+    while ((n = merger.ReadBatch(batch.data(), batch.size())) > 0)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const MarketEvent& ev = batch[i];
+            Require(ev.sendingTime >= prev, "KWayMerger: events out of order");
+            prev = ev.sendingTime;
+            // Per-source order is preserved
+            const size_t s = static_cast<size_t>(ev.Bid());
+            Require(ev.Ask() == nextPerSource[s]++, "KWayMerger: source order broken");
+            ++count;
+        }
+    }
+    Require(count == total, "KWayMerger: expected every event once");
+    PrintOk("KWayMerger merges many sources in order");
+}
+
+void TestKWayMerger_WindowMergesLikeFullDay()
+{
+    // Enough sources that the initial tournament and the replays play ties
+    // in different orders, with collisions both across and within sources
+    const size_t k = 6;
+    const unsigned seed = 11;
+    std::mt19937 rng(5);
+    std::vector<std::vector<MarketEvent>> streams(k);
+    for (size_t s = 0; s < k; ++s)
+    {
+        long long t = 1000;
+        for (int i = 0; i < 2000; ++i)
+        {
+            t += static_cast<long long>(rng() % 3);
+            streams[s].push_back(MakeQuote(t, InstrumentId::FutureA, static_cast<double>(s), static_cast<double>(i)));
+        }
+    }
+
+    auto merge = [&](long long start, long long end) {
+        std::vector<std::unique_ptr<VectorEventSource>> owned;
+        std::vector<IEventSource*> sources;
+        for (auto& stream : streams)
+        {
+            owned.push_back(std::make_unique<VectorEventSource>(stream));
+            sources.push_back(owned.back().get());
+        }
+        KWayMerger merger(sources, seed);
+        merger.SetTimeWindow(start, end);
+        std::vector<MarketEvent> out;
+        MarketEvent ev{};
+        while (merger.ReadNext(ev))
+            out.push_back(ev);
+        return out;
+    };
+
+    const std::vector<MarketEvent> full =
+        merge(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max());
+    for (size_t from : { size_t(1), full.size() / 5, full.size() / 2, full.size() - 50 })
+    {
+        const long long start = full[from].sendingTime;
+        const long long end = full[std::min(full.size() - 1, from + 700)].sendingTime;
+        const std::vector<MarketEvent> window = merge(start, end);
+
+        size_t i = 0;
+        while (full[i].sendingTime < start)
+            ++i;
+        for (const MarketEvent& ev : window)
+        {
+            Require(i < full.size() && full[i].sendingTime < end, "KWayMerger: window produced extra events");
+            Require(ev.Bid() == full[i].Bid() && ev.Ask() == full[i].Ask(),
+                    "KWayMerger: window order differs from full-day merge at t=" + std::to_string(ev.sendingTime));
+            ++i;
+        }
+        Require(i == full.size() || full[i].sendingTime >= end, "KWayMerger: window ended early");
+    }
+
+    PrintOk("KWayMerger windows merge exactly like the full day");
+}
+
 void TestStreamMergerContainsFutureB()
 {
     CsvReader readerA("Data/FutureA.csv");
@@ -495,8 +2384,8 @@ void TestPnlTrackerBuyAndMarkToMarket()
     PnlTracker pnl;
 
     MarketEvent quote{};
-    quote.bid = 100.0;
-    quote.ask = 102.0;
+    quote.bidTicks = PriceToTicks(100.0);
+    quote.askTicks = PriceToTicks(102.0);
 
     pnl.OnQuoteB(quote);
     pnl.ApplyTradeB(0, Side::Buy, 102.0, 1);
@@ -515,8 +2404,8 @@ void TestPnlTrackerRoundTrip()
     PnlTracker pnl;
 
     MarketEvent quote{};
-    quote.bid = 100.0;
-    quote.ask = 102.0;
+    quote.bidTicks = PriceToTicks(100.0);
+    quote.askTicks = PriceToTicks(102.0);
 
     pnl.OnQuoteB(quote);
 
@@ -534,8 +2423,8 @@ void TestPnlTrackerMaxExposure()
     PnlTracker pnl;
 
     MarketEvent quote{};
-    quote.bid = 10.0;
-    quote.ask = 11.0;
+    quote.bidTicks = PriceToTicks(10.0);
+    quote.askTicks = PriceToTicks(11.0);
 
     pnl.OnQuoteB(quote);
 
@@ -719,6 +2608,29 @@ void TestConfig_GetValidatedPath_RejectsDoubleDot()
     PrintOk("Config rejects paths with embedded ..");
 }
 
+void TestConfig_GetIntList_RejectsOutOfRange()
+{
+    TempFile configFile("Data/_tmp_config_intlist.cfg");
+    WriteTextFile(configFile.Path(), "Sweep.MaxAbsExposureLots=1,2,3\nSweep.Huge=1,1e12\nSweep.Fraction=1.5\n");
+
+    Config cfg(configFile.Path());
+    Require(cfg.GetIntList("Sweep.MaxAbsExposureLots") == std::vector<int>{ 1, 2, 3 }, "Config: int list not parsed");
+    for (const char* key : { "Sweep.Huge", "Sweep.Fraction" })
+    {
+        bool threw = false;
+        try
+        {
+            cfg.GetIntList(key);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Require(threw, std::string("Config: expected GetIntList to reject ") + key);
+    }
+    PrintOk("Config int lists reject fractions and values outside int");
+}
+
 //================= Test Runner =================//
 
 int main()
@@ -728,11 +2640,53 @@ int main()
         // CsvReader tests
         TestCsvReaderReadsFirstLine();
         TestCsvReaderEof();
+        TestCsvReader_MemoryMappedMatchesStream();
+        TestCsvReader_MemoryMappedErrorIncludesLine();
+        TestCsvReader_MemoryMappedAcrossScanBlocks();
+        TestCsvScanner_AllKindsAgree();
+
+        // BinaryEventFile tests
+        TestBinaryEventFile_RoundTripMatchesCsv();
+        TestBinaryEventFile_RejectsTruncatedFile();
+        TestBinaryEventFile_RejectsCorruptHeaderAndInstrument();
+
+#ifdef ARBSIM_HAVE_ZLIB
+        // Compressed input tests
+        TestCsvReader_GzipMatchesPlain();
+        TestCsvReader_GzipTruncatedThrows();
+#endif
+
+        // Time-range replay tests
+        TestTimeIndex_SeekMatchesFullScan();
+        TestTimeIndex_RebuildsStaleSidecar();
+        TestTimeIndex_RebuildsCorruptCount();
+        TestStreamMerger_TimeWindow();
+
+        // Timeline cache tests
+        TestTimelineCache_ReplaysMergedTimeline();
+
+        // ParallelCsvReader tests
+        TestParallelCsvReader_MatchesSerial();
+        TestParallelCsvReader_ErrorAfterPrecedingEvents();
+
+        // PrefetchingEventSource tests
+        TestPrefetchingEventSource_MatchesDirectReader();
+        TestPrefetchingEventSource_RethrowsAfterPrecedingEvents();
+        TestPrefetchingEventSource_EarlyDestruction();
+
+        // PriceParser tests
+        TestPriceParser_BitExactWithStrtod();
 
         // StreamMerger tests
         TestStreamMergerOrdering();
         TestStreamMergerContainsFutureB();
+        TestStreamMerger_ReadBatchMatchesReadNext();
+        TestKWayMerger_TwoSourcesMatchStreamMerger();
+        TestKWayMerger_ManySourcesSortedAndComplete();
+        TestKWayMerger_WindowMergesLikeFullDay();
+        TestCsvReader_ReadEventsDefersErrorAfterEvents();
         TestStreamMergerTieBreak_AFirstOnEqualTimestamp();
+        TestStreamMerger_WindowMergesLikeFullDay();
 
         // PnlTracker tests
         TestPnlTrackerInitialState();
@@ -753,7 +2707,22 @@ int main()
         TestSimulationEngine_SellB_WhenExecutableSellEdge();
         TestSimulationEngine_BuyB_WhenExecutableBuyEdge();
         TestSimulationEngine_StopLoss_ClosesAsTradeAndStops();
+        TestSimulationEngine_OnEvents_StopsAtStopLoss();
+        TestSimulationEngine_StoreReplayMatchesOnEvents();
+        TestParameterSweep_MatchesSequentialRuns();
+        TestMultiConfigEngine_MatchesPerConfigEngines();
+        TestFixedPointStrategy_ThresholdTicksExact();
+        TestFixedPointStrategy_MatchesDoublePath();
         TestSimulationEngine_EndOfDayClose_Tagged();
+        TestSimulationEngine_CustomStrategyPolicy();
+        TestAsyncTradeWriter_MatchesInMemoryLog();
+        TestSpillingTradeSink_MatchesInMemoryLog();
+        TestOutputBuffer_MatchesStreamFormatting();
+        TestPnlSeries_WritesNdjsonAndBinary();
+        TestDownsamplePnlSeries_KeepsExtremes();
+        TestBatchRunner_MatchesSingleDayRuns();
+        TestCheckpoint_ResumeMatchesFullRun();
+        TestCheckpoint_ResumeFromReadersMatchesFullRun();
         TestSimulationEngine_BuyBlocked_WhenAskSizeZero();
         TestSimulationEngine_SellBlocked_WhenBidSizeZero();
 
@@ -771,6 +2740,7 @@ int main()
         TestConfig_GetValidatedPath_RejectsPathTraversal();
         TestConfig_GetValidatedPath_AcceptsValidPath();
         TestConfig_GetValidatedPath_RejectsDoubleDot();
+        TestConfig_GetIntList_RejectsOutOfRange();
     }
     catch (const std::exception& e)
     {
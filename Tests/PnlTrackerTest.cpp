@@ -12,9 +12,9 @@ protected:
   // Helper to create a dummy quote
   MarketEvent CreateQuote(double bid, double ask) {
     MarketEvent ev{};
-    ev.bid = bid;
-    ev.ask = ask;
-    // PnlTracker uses CalcMid = (bid+ask)*0.5
+    ev.bidTicks = PriceToTicks(bid);
+    ev.askTicks = PriceToTicks(ask);
+    // PnlTracker uses mid = (bidTicks+askTicks)/2
     return ev;
   }
 };
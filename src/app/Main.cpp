@@ -1,17 +1,36 @@
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <filesystem>
+#include <fstream>
 
 #include "../config/Config.h"
+#include "../core/AsyncTradeWriter.h"
+#include "../core/BatchRunner.h"
+#include "../core/Checkpoint.h"
 #include "../core/Constants.h"
-#include "../core/CsvReader.h"
+#include "../core/EventSourceFactory.h"
+#include "../core/EventStore.h"
+#include "../core/FixedPointStrategy.h"
 #include "../core/MarketData.h"
+#include "../core/OutputBuffer.h"
+#include "../core/ParameterSweep.h"
+#include "../core/PnlSeries.h"
 #include "../core/PnlTracker.h"
+#include "../core/PrefetchingEventSource.h"
 #include "../core/SimulationEngine.h"
 #include "../core/Strategy.h"
 #include "../core/StreamMerger.h"
+#include "../core/ThreadPool.h"
+#include "../core/TimelineCache.h"
+#include "../core/TimeWindowEventSource.h"
+#include "../core/TradeLog.h"
 
 using namespace ArbSim;
 
@@ -25,106 +44,629 @@ static double Sec(Clock::time_point a, Clock::time_point b) {
     return std::chrono::duration<double>(b - a).count();
 }
 
-int main(int argc, char* argv[]) {
-    std::cout << "Current Path: " << std::filesystem::current_path() << std::endl;
+static bool IsSweep(const Config& cfg) {
+    return cfg.HasKey("Sweep.MinArbitrageEdge") || cfg.HasKey("Sweep.MaxAbsExposureLots") ||
+        cfg.HasKey("Sweep.StopLossPnl");
+}
 
-    try {
-        // 1. Optimize I/O for performance
-        std::ios::sync_with_stdio(false);
-        std::cin.tie(nullptr);
+// Optional thread or lane count; 0 (the default) lets the pool pick
+static size_t GetCount(const Config& cfg, const std::string& key) {
+    if (!cfg.HasKey(key)) {
+        return 0;
+    }
+    const int value = cfg.GetInt(key);
+    if (value < 0) {
+        throw std::runtime_error(key + " must be >= 0");
+    }
+    return static_cast<size_t>(value);
+}
 
-        const auto t_total0 = Clock::now();
+// Sweep mode: load and merge the day once into an EventStore, then run every
+// combination of the Sweep.* lists (Strategy.* for a missing list) on a
+// thread pool and write one summary row per combination.
+static void RunSweepMode(const Config& cfg, ThreadPool* parsePool) {
+    const auto t0 = Clock::now();
 
-        // 2. Load Configuration
-        // If an argument is provided, use it; otherwise, fall back to default
-        std::string path = (argc > 1) ? argv[1] : "config/config.cfg";
-        Config cfg(path);
+    EventStore store;
+    if (cfg.HasKey("Data.CacheDir")) {
+        std::unique_ptr<IEventSource> timeline = TimelineCache::Open(cfg.GetValidatedPath("Data.CacheDir"),
+            cfg.GetValidatedPath("Data.FutureA"), cfg.GetValidatedPath("Data.FutureB"), kMergeSeed, parsePool);
+        store = EventStore::Load(*timeline);
+    } else {
+        std::unique_ptr<IEventSource> readerA = OpenEventSource(cfg.GetValidatedPath("Data.FutureA"), parsePool);
+        std::unique_ptr<IEventSource> readerB = OpenEventSource(cfg.GetValidatedPath("Data.FutureB"), parsePool);
+        store = EventStore::LoadMerged(*readerA, *readerB, kMergeSeed);
+    }
 
-        // 3. Initialize Data Readers (with path validation for security)
-        CsvReader readerA(cfg.GetValidatedPath("Data.FutureA"));
-        CsvReader readerB(cfg.GetValidatedPath("Data.FutureB"));
-        StreamMerger merger(readerA, readerB);
+    const size_t begin = cfg.HasKey("Data.StartTime") ? store.LowerBound(cfg.GetInt64("Data.StartTime")) : 0;
+    const size_t end = cfg.HasKey("Data.EndTime") ? store.LowerBound(cfg.GetInt64("Data.EndTime")) : store.Size();
+
+    const std::vector<StrategyParams> grid = MakeSweepGrid(
+        cfg.HasKey("Sweep.MinArbitrageEdge") ? cfg.GetDoubleList("Sweep.MinArbitrageEdge")
+                                             : std::vector<double>{ cfg.GetDouble("Strategy.MinArbitrageEdge") },
+        cfg.HasKey("Sweep.MaxAbsExposureLots") ? cfg.GetIntList("Sweep.MaxAbsExposureLots")
+                                               : std::vector<int>{ cfg.GetInt("Strategy.MaxAbsExposureLots") },
+        cfg.HasKey("Sweep.StopLossPnl") ? cfg.GetDoubleList("Sweep.StopLossPnl")
+                                        : std::vector<double>{ cfg.GetDouble("Strategy.StopLossPnl") });
+
+    const auto t1 = Clock::now();
+
+    ThreadPool pool(GetCount(cfg, "Sweep.Threads"));
+    const size_t lanes = std::max<size_t>(GetCount(cfg, "Sweep.Lanes"), 1);
+    const std::vector<SweepResult> results = RunSweep(store, begin, begin < end ? end : begin, grid, pool, lanes);
+
+    const auto t2 = Clock::now();
+
+    if (cfg.HasKey("Sweep.Output")) {
+        const std::string outPath = cfg.GetValidatedPath("Sweep.Output");
+        std::ofstream out(outPath);
+        if (!out) {
+            throw std::runtime_error("Sweep: Failed to create output file: " + outPath);
+        }
+        WriteSweepCsv(out, results);
+    } else {
+        WriteSweepCsv(std::cout, results);
+    }
+
+    const double runSec = Sec(t1, t2);
+    std::cout << "\nTiming Statistics\n";
+    std::cout << "Events in store: " << store.Size() << " (" << store.MemoryBytes() / (1024.0 * 1024.0) << " MB)\n";
+    std::cout << "Load + merge time: " << Ms(t0, t1) << " ms\n";
+    std::cout << "Sweep: " << grid.size() << " parameter sets on " << pool.Size() << " threads, "
+        << lanes << " per engine, in "
+        << Ms(t1, t2) << " ms\n";
+    std::cout << "Throughput: " << (runSec > 0.0 ? (static_cast<double>(end > begin ? end - begin : 0) * grid.size() / runSec) : 0.0)
+        << " events/sec\n";
+}
+
+// Batch mode: every day of the Batch.Manifest is replayed independently on a
+// pool of Batch.Threads workers with the Strategy.* parameters; one summary
+// row per day, then the portfolio total. Each day's inputs honour the same
+// Data.* options as a single replay.
+static bool RunBatchMode(const Config& cfg, ThreadPool* parsePool) {
+    if (cfg.HasKey("Data.CacheDir")) {
+        throw std::runtime_error("Data.CacheDir is not supported in batch mode");
+    }
+    const auto t0 = Clock::now();
+
+    std::vector<BatchDay> days = ReadBatchManifest(cfg.GetValidatedPath("Batch.Manifest"));
+    for (size_t i = 0; i < days.size(); ++i) {
+        const std::string where = "Batch.Manifest day " + std::to_string(i + 1);
+        days[i].futureA = cfg.ValidatePath(days[i].futureA, where);
+        days[i].futureB = cfg.ValidatePath(days[i].futureB, where);
+    }
+    const StrategyParams params = Strategy(cfg).GetParams();
+
+    BatchDataOptions data;
+    if (cfg.HasKey("Data.StartTime")) {
+        data.startTime = cfg.GetInt64("Data.StartTime");
+    }
+    if (cfg.HasKey("Data.EndTime")) {
+        data.endTime = cfg.GetInt64("Data.EndTime");
+    }
+    data.parsePool = parsePool;
+    data.prefetch = cfg.HasKey("Data.Prefetch") && cfg.GetInt("Data.Prefetch") != 0;
+
+    ThreadPool pool(GetCount(cfg, "Batch.Threads"));
+    const std::vector<BatchDayResult> results = RunBatch(days, params, pool, data);
+    const BatchTotal total = SumBatch(results);
+
+    const auto t1 = Clock::now();
+
+    if (cfg.HasKey("Batch.Output")) {
+        const std::string outPath = cfg.GetValidatedPath("Batch.Output");
+        std::ofstream out(outPath);
+        if (!out) {
+            throw std::runtime_error("Batch: Failed to create output file: " + outPath);
+        }
+        WriteBatchCsv(out, results);
+    } else {
+        WriteBatchCsv(std::cout, results);
+    }
+    PrintBatchTotal(std::cout, total);
+    for (const BatchDayResult& r : results) {
+        if (!r.error.empty()) {
+            std::cerr << "Batch day failed (" << r.day.futureA << ", " << r.day.futureB << "): " << r.error << "\n";
+        }
+    }
+
+    const double runSec = Sec(t0, t1);
+    std::cout << "\nTiming Statistics\n";
+    std::cout << "Batch: " << days.size() << " days on " << pool.Size() << " threads in " << Ms(t0, t1) << " ms\n";
+    std::cout << "Throughput: " << (runSec > 0.0 ? (static_cast<double>(total.events) / runSec) : 0.0)
+        << " events/sec\n";
+    return total.failedDays == 0;
+}
+
+using ReadBatchFn = std::function<size_t(MarketEvent*, size_t)>;
+
+struct SimulationRun {
+    std::uint64_t events;
+    Clock::time_point loopStart;
+    Clock::time_point loopEnd;
+    double onEventMsSum;
+    std::uint64_t checkpoints;
+};
 
-        // 4. Initialize Core Components with Static Polymorphism
-        // Create the concrete strategy directly on the stack for best locality
-        Strategy strategy(cfg);
-        PnlTracker pnl;
+// Where RunSimulation's output goes besides stdout, and how it starts
+struct SimulationOutputs {
+    ITradeSink* tradeSink;      // fills, instead of the printed trade log
+    PnlSeries* series;          // PnL samples, instead of the printed PNL lines
+    const Checkpoint* resume;   // state to continue from
+    std::string checkpointPath; // periodic checkpoints when not empty
+    std::uint64_t checkpointEveryEvents;
+    std::uint64_t inputHash;    // CheckpointInputHash() of the inputs
+    long long windowStart;      // configured Data.StartTime / Data.EndTime
+    long long windowEnd;
+};
 
-        // Pre-allocate log buffer to prevent heap fragmentation during hot loop
-        std::string tradeBuf;
-        tradeBuf.reserve(kTradeLogBufferSize);
+// PnL sampling: after the first event at or past the next sample time, or
+// after every everyEvents events when that is > 0
+struct PnlSampling {
+    long long intervalNs;
+    std::uint64_t everyEvents;
+};
 
-        // Create simulation engine with strategy and PnL tracker
-        SimulationEngine engine(std::move(strategy), pnl, tradeBuf);
+// The stdout PNL lines keep the fixed 60 s interval; a PnlSeries samples at
+// PnlSeries.IntervalMs (default 1000) or every PnlSeries.EveryEvents events
+static PnlSampling ReadPnlSampling(const Config& cfg, bool series) {
+    PnlSampling sampling{ kPnlPrintIntervalNs, 0 };
+    if (!series) {
+        return sampling;
+    }
+    const long long intervalMs = cfg.HasKey("PnlSeries.IntervalMs") ? cfg.GetInt64("PnlSeries.IntervalMs") : 1000;
+    const long long everyEvents = cfg.HasKey("PnlSeries.EveryEvents") ? cfg.GetInt64("PnlSeries.EveryEvents") : 0;
+    if (intervalMs <= 0 || everyEvents < 0) {
+        throw std::runtime_error("PnlSeries.IntervalMs must be > 0 and PnlSeries.EveryEvents >= 0");
+    }
+    sampling.intervalNs = intervalMs * (kNanosecondsPerSecond / 1000);
+    sampling.everyEvents = static_cast<std::uint64_t>(everyEvents);
+    return sampling;
+}
 
-        // 5. Simulation Loop Variables
-        MarketEvent ev{};
-        long long lastTime = 0;
-        std::uint64_t events = 0;
-        long long nextPrintTime = 0;
+// Replays the merged timeline through a SimulationEngine<StrategyT>, then
+// prints the trade log (unless fills go to a trade sink) and the summary. PnL
+// samples go to the series when given, else to stdout as PNL lines. With a
+// resume checkpoint, readBatch must start after its lastTime. One
+// instantiation per strategy: the strategy type is resolved once here, never
+// per event.
+template <typename StrategyT>
+static SimulationRun RunSimulation(const Config& cfg, const ReadBatchFn& readBatch, const SimulationOutputs& outputs) {
+    ITradeSink* const tradeSink = outputs.tradeSink;
+    PnlSeries* const series = outputs.series;
+
+    // 4. Initialize Core Components with Static Polymorphism
+    // Create the concrete strategy directly on the stack for best locality
+    StrategyT strategy(cfg);
+    PnlTracker pnl;
+
+    // Trades printed to stdout collect in a capped buffer that spills to a
+    // temp file (TradeLog.MemoryCapBytes, default kTradeLogBufferSize)
+    const long long tradeLogCap = cfg.HasKey("TradeLog.MemoryCapBytes")
+        ? cfg.GetInt64("TradeLog.MemoryCapBytes") : static_cast<long long>(kTradeLogBufferSize);
+    if (tradeLogCap <= 0) {
+        throw std::runtime_error("TradeLog.MemoryCapBytes must be > 0");
+    }
+    SpillingTradeSink stdoutSink(static_cast<size_t>(tradeLogCap));
+
+    // Engine output (PnL lines, trade log, summary) is formatted with
+    // to_chars and goes to stdout in one write per 64KB; std::cout is
+    // flushed first so the two never interleave
+    std::cout.flush();
+    OutputBuffer out(kStdoutFd);
+
+    // Create simulation engine with strategy and PnL tracker
+    SimulationEngine<StrategyT> engine(std::move(strategy), pnl,
+        tradeSink != nullptr ? *tradeSink : static_cast<ITradeSink&>(stdoutSink));
+
+    // 5. Simulation Loop Variables
+    // Merged events are processed in cache-resident blocks
+    std::vector<MarketEvent> batch(kEventBatchSize);
+    long long lastTime = 0;
+    std::uint64_t events = 0;
+    const PnlSampling sampling = ReadPnlSampling(cfg, series != nullptr);
+    long long nextSampleTime = sampling.everyEvents > 0 ? std::numeric_limits<long long>::max() : 0;
+    std::uint64_t nextSampleEvent = sampling.everyEvents > 0
+        ? sampling.everyEvents : std::numeric_limits<std::uint64_t>::max();
+
+    // Checkpoints are written between two timestamps once due (Checkpoint.h)
+    const std::uint64_t checkpointEvery = outputs.checkpointPath.empty() ? 0 : outputs.checkpointEveryEvents;
+    CheckpointSchedule checkpointSchedule(checkpointEvery);
+    std::uint64_t checkpoints = 0;
+
+    std::uint64_t resumedEvents = 0;
+    if (outputs.resume != nullptr) {
+        const Checkpoint& cp = *outputs.resume;
+        engine.RestoreState(cp.engine);
+        events = cp.events;
+        resumedEvents = cp.events;
+        lastTime = cp.lastTime;
+        // Keep the sampling position unless the sampling mode changed
+        const bool cpByEvents = cp.nextSampleEvent != std::numeric_limits<std::uint64_t>::max();
+        if (cpByEvents == (sampling.everyEvents > 0)) {
+            nextSampleTime = cp.nextSampleTime;
+            nextSampleEvent = cp.nextSampleEvent;
+        }
+        checkpointSchedule = CheckpointSchedule(checkpointEvery, events);
+    }
 
 #ifdef ENABLE_PER_EVENT_TIMING
-        double onEventMsSum = 0.0;
+    double onEventMsSum = 0.0;
 #endif
 
-        const auto t_loop0 = Clock::now();
+    SimulationRun run{};
+    run.loopStart = Clock::now();
 
-        // 6. Main Event Loop (Hot Path)
-        while (merger.ReadNext(ev)) {
-            lastTime = ev.sendingTime;
+    // 6. Main Event Loop (Hot Path)
+    size_t count = 0;
+    while (!engine.IsStopped() && (count = readBatch(batch.data(), batch.size())) > 0) {
+        size_t pos = 0;
+        while (pos < count) {
+            if (checkpointSchedule.IsDue(events, batch[pos].sendingTime, lastTime)) {
+                Checkpoint cp{};
+                cp.engine = engine.SaveState();
+                cp.inputHash = outputs.inputHash;
+                cp.startTime = outputs.windowStart;
+                cp.endTime = outputs.windowEnd;
+                cp.events = events;
+                cp.lastTime = lastTime;
+                cp.nextSampleTime = nextSampleTime;
+                cp.nextSampleEvent = nextSampleEvent;
+                WriteCheckpointFile(outputs.checkpointPath, cp);
+                ++checkpoints;
+                checkpointSchedule.Taken(events);
+            }
+
+            // Run up to and including the next PnL sample boundary, so
+            // the sample sees the engine state right after that event, and
+            // no further than the next checkpoint check.
+            const std::uint64_t untilSample = std::min(nextSampleEvent - events,
+                checkpointSchedule.EventsUntilDue(events));
+            size_t end = pos;
+            while (end < count && end - pos + 1 < untilSample && batch[end].sendingTime < nextSampleTime) {
+                ++end;
+            }
+            if (end < count) {
+                ++end;
+            }
 
 #ifdef ENABLE_PER_EVENT_TIMING
             const auto t0 = Clock::now();
 #endif
 
             // Static dispatch happens here
-            engine.OnEvent(ev);
+            const size_t done = engine.OnEvents(batch.data() + pos, end - pos);
 
 #ifdef ENABLE_PER_EVENT_TIMING
             const auto t1 = Clock::now();
             onEventMsSum += Ms(t0, t1);
 #endif
 
-            // Periodic PnL Snapshot printing
-            if (ev.sendingTime >= nextPrintTime) {
-                if (nextPrintTime != 0) {
-                    std::cout << ev.sendingTime << ",PNL," << engine.GetTotalPnl() << ","
+            pos += done;
+            events += done;
+            const MarketEvent& ev = batch[pos - 1];
+            lastTime = ev.sendingTime;
+
+            // Periodic PnL snapshot: a series row, or a printed line
+            if (ev.sendingTime >= nextSampleTime || events >= nextSampleEvent) {
+                if (series != nullptr) {
+                    const PnlTracker& tracker = engine.GetPnl();
+                    series->Record(ev.sendingTime, tracker.GetTotalPnlTicks(), tracker.GetLastMidBTicks(),
+                        tracker.GetPositionB());
+                } else if (nextSampleTime != 0) {
+                    out << ev.sendingTime << ",PNL," << engine.GetTotalPnl() << ","
                         << engine.GetLastMidB() << "," << engine.GetLastMidA()
                         << "\n";
                 }
-                nextPrintTime = ev.sendingTime + kPnlPrintIntervalNs;
+                if (sampling.everyEvents > 0) {
+                    nextSampleEvent = events + sampling.everyEvents;
+                } else {
+                    nextSampleTime = ev.sendingTime + sampling.intervalNs;
+                }
             }
 
-            ++events;
-
             if (engine.IsStopped()) {
                 break;
             }
         }
+    }
 
-        const auto t_loop1 = Clock::now();
+    run.loopEnd = Clock::now();
+    run.events = events - resumedEvents;
+    run.checkpoints = checkpoints;
+#ifdef ENABLE_PER_EVENT_TIMING
+    run.onEventMsSum = onEventMsSum;
+#endif
+
+    // 7. End of Day Cleanup
+    engine.OnEndOfDay(lastTime);
 
-        // 7. End of Day Cleanup
-        engine.OnEndOfDay(lastTime);
+    // 8. Output Results
+    stdoutSink.WriteTo(out); // Dump the trade log, spilled part first
+    engine.PrintSummary(out);
+    out.Flush();
+
+    return run;
+}
 
-        // 8. Output Results
-        std::cout << tradeBuf; // Dump the pre-allocated trade log
-        engine.PrintSummary(std::cout);
+using StrategyRunner = SimulationRun (*)(const Config&, const ReadBatchFn&, const SimulationOutputs&);
+
+// Strategy.Type -> engine instantiation. A new strategy is one more row; its
+// type needs a Config constructor and the IsStrategyPolicy interface.
+struct StrategyEntry {
+    const char* type;
+    StrategyRunner run;
+};
+
+static const StrategyEntry kStrategies[] = {
+    { "Arbitrage", &RunSimulation<Strategy> },
+    { "FixedPoint", &RunSimulation<FixedPointStrategy> },
+};
+
+static StrategyRunner FindStrategyRunner(const Config& cfg) {
+    const std::string type = cfg.HasKey("Strategy.Type") ? cfg.GetString("Strategy.Type") : kStrategies[0].type;
+    std::string known;
+    for (const StrategyEntry& entry : kStrategies) {
+        if (type == entry.type) {
+            return entry.run;
+        }
+        known += known.empty() ? entry.type : std::string(", ") + entry.type;
+    }
+    throw std::runtime_error("Unknown Strategy.Type '" + type + "' (known: " + known + ")");
+}
+
+static TradeLogFormat ParseTradeLogFormat(const Config& cfg) {
+    const std::string format = cfg.HasKey("TradeLog.Format") ? cfg.GetString("TradeLog.Format") : "text";
+    if (format == "text") {
+        return TradeLogFormat::Text;
+    }
+    if (format == "binary") {
+        return TradeLogFormat::Binary;
+    }
+    throw std::runtime_error("Unknown TradeLog.Format '" + format + "' (known: text, binary)");
+}
+
+static PnlSeriesFormat ParsePnlSeriesFormat(const Config& cfg) {
+    const std::string format = cfg.HasKey("PnlSeries.Format") ? cfg.GetString("PnlSeries.Format") : "ndjson";
+    if (format == "ndjson") {
+        return PnlSeriesFormat::Ndjson;
+    }
+    if (format == "binary") {
+        return PnlSeriesFormat::Binary;
+    }
+    throw std::runtime_error("Unknown PnlSeries.Format '" + format + "' (known: ndjson, binary)");
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "Current Path: " << std::filesystem::current_path() << std::endl;
+
+    try {
+        // 1. Optimize I/O for performance
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
+
+        const auto t_total0 = Clock::now();
+
+        // 2. Load Configuration
+        // ArbSim [config] [--resume <checkpoint>]; the config defaults to
+        // config/config.cfg
+        std::string path = "config/config.cfg";
+        std::string resumePath;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--resume") {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("--resume needs a checkpoint file");
+                }
+                resumePath = argv[++i];
+            } else {
+                path = arg;
+            }
+        }
+        Config cfg(path);
+
+        // Optional: parse plain CSV inputs in parallel chunks (shared pool)
+        std::unique_ptr<ThreadPool> parsePool;
+        if (cfg.HasKey("Data.ParseThreads") && cfg.GetInt("Data.ParseThreads") > 0) {
+            parsePool = std::make_unique<ThreadPool>(static_cast<size_t>(cfg.GetInt("Data.ParseThreads")));
+        }
+
+        // Resolve Strategy.Type before any data is read
+        const StrategyRunner runStrategy = FindStrategyRunner(cfg);
+
+        if (!resumePath.empty() && (IsSweep(cfg) || cfg.HasKey("Batch.Manifest"))) {
+            throw std::runtime_error("--resume applies to a single replay, not to sweep or batch mode");
+        }
+
+        if (IsSweep(cfg)) {
+            // The sweep engines evaluate the default Strategy only
+            if (runStrategy != kStrategies[0].run) {
+                throw std::runtime_error("Sweep mode supports Strategy.Type=" + std::string(kStrategies[0].type) + " only");
+            }
+            RunSweepMode(cfg, parsePool.get());
+            return 0;
+        }
+
+        if (cfg.HasKey("Batch.Manifest")) {
+            // Each day runs the default Strategy, as in sweep mode
+            if (runStrategy != kStrategies[0].run) {
+                throw std::runtime_error("Batch mode supports Strategy.Type=" + std::string(kStrategies[0].type) + " only");
+            }
+            return RunBatchMode(cfg, parsePool.get()) ? 0 : 1;
+        }
+
+        // Optional: replay only [Data.StartTime, Data.EndTime)
+        const long long windowStart = cfg.HasKey("Data.StartTime")
+            ? cfg.GetInt64("Data.StartTime") : std::numeric_limits<long long>::min();
+        const long long windowEnd = cfg.HasKey("Data.EndTime")
+            ? cfg.GetInt64("Data.EndTime") : std::numeric_limits<long long>::max();
+
+        // Optional: continue a replay from a checkpoint of the same inputs
+        // (by contents) and window. The inputs are read again from just after
+        // its last timestamp. Hashing reads both files, so it is only done
+        // when checkpoints are written or resumed.
+        std::uint64_t inputHash = 0;
+        if (!resumePath.empty() || cfg.HasKey("Checkpoint.Path")) {
+            inputHash = CheckpointInputHash(
+                { cfg.GetValidatedPath("Data.FutureA"), cfg.GetValidatedPath("Data.FutureB") });
+        }
+        std::unique_ptr<Checkpoint> resume;
+        if (!resumePath.empty()) {
+            resume = std::make_unique<Checkpoint>(ReadCheckpointFile(resumePath));
+            if (resume->inputHash != inputHash) {
+                throw std::runtime_error("Checkpoint " + resumePath
+                    + " was taken over other or changed Data.FutureA / Data.FutureB files");
+            }
+            if (resume->startTime != windowStart || resume->endTime != windowEnd) {
+                throw std::runtime_error("Checkpoint " + resumePath
+                    + " was taken with another Data.StartTime / Data.EndTime window");
+            }
+        }
+
+        // 3. Initialize Data Readers (with path validation for security)
+        // CSV or binary event files, detected by the file's magic bytes.
+        // With Data.CacheDir the merged A/B timeline is saved there on the
+        // first run and replayed from that single file afterwards.
+        std::vector<std::unique_ptr<IEventSource>> sources;
+        const bool useCache = cfg.HasKey("Data.CacheDir");
+        bool cacheBuilt = false;
+        if (useCache) {
+            sources.push_back(TimelineCache::Open(cfg.GetValidatedPath("Data.CacheDir"),
+                cfg.GetValidatedPath("Data.FutureA"), cfg.GetValidatedPath("Data.FutureB"),
+                kMergeSeed, parsePool.get(), &cacheBuilt));
+        } else {
+            sources.push_back(OpenEventSource(cfg.GetValidatedPath("Data.FutureA"), parsePool.get()));
+            sources.push_back(OpenEventSource(cfg.GetValidatedPath("Data.FutureB"), parsePool.get()));
+        }
+
+        // Readers jump to the window start, or past the checkpoint, through
+        // their index before any prefetch thread starts
+        long long startTime = windowStart;
+        const long long endTime = windowEnd;
+        if (resume && resume->lastTime >= startTime) {
+            startTime = resume->lastTime + 1;
+        }
+        if (cfg.HasKey("Data.StartTime") || resume) {
+            for (auto& source : sources) {
+                source->SeekToTime(startTime);
+            }
+        }
+
+        // Optional: parse each stream ahead on its own producer thread
+        if (cfg.HasKey("Data.Prefetch") && cfg.GetInt("Data.Prefetch") != 0) {
+            for (auto& source : sources) {
+                source = std::make_unique<PrefetchingEventSource>(std::move(source));
+            }
+        }
+
+        // The merged timeline: A and B through StreamMerger, or the cached
+        // timeline, already merged, cut to the time window directly
+        std::unique_ptr<StreamMerger> pairMerger;
+        ReadBatchFn readBatch;
+        if (sources.size() == 2) {
+            pairMerger = std::make_unique<StreamMerger>(*sources[0], *sources[1], kMergeSeed);
+            pairMerger->SetTimeWindow(startTime, endTime);
+            readBatch = [&](MarketEvent* out, size_t max) { return pairMerger->ReadBatch(out, max); };
+        } else {
+            sources[0] = std::make_unique<TimeWindowEventSource>(std::move(sources[0]), startTime, endTime);
+            IEventSource* const timeline = sources[0].get();
+            readBatch = [timeline](MarketEvent* out, size_t max) { return timeline->ReadEvents(out, max); };
+        }
+
+        // Optional: fills go to a file through a background writer instead
+        // of the in-memory log printed at the end
+        std::unique_ptr<AsyncTradeWriter> tradeWriter;
+        if (cfg.HasKey("TradeLog.Path")) {
+            tradeWriter = std::make_unique<AsyncTradeWriter>(cfg.GetValidatedPath("TradeLog.Path"), ParseTradeLogFormat(cfg));
+        }
+
+        // Optional: PnL samples go to a series file, written after the
+        // loop, instead of the printed PNL lines
+        std::unique_ptr<PnlSeries> pnlSeries;
+        PnlSeriesFormat pnlSeriesFormat = PnlSeriesFormat::Ndjson;
+        std::string pnlSeriesPath;
+        size_t pnlSeriesMaxPoints = 0;
+        if (cfg.HasKey("PnlSeries.Path")) {
+            pnlSeriesPath = cfg.GetValidatedPath("PnlSeries.Path");
+            pnlSeriesFormat = ParsePnlSeriesFormat(cfg);
+            // 0 writes every sample; checked here so a bad value fails
+            // before the replay, not after it
+            const long long maxPoints = cfg.HasKey("PnlSeries.MaxPoints") ? cfg.GetInt64("PnlSeries.MaxPoints") : 0;
+            if (maxPoints < 0 || (maxPoints > 0 && maxPoints < static_cast<long long>(kMinDownsamplePoints))) {
+                throw std::runtime_error("PnlSeries.MaxPoints must be 0 or >= " + std::to_string(kMinDownsamplePoints));
+            }
+            pnlSeriesMaxPoints = static_cast<size_t>(maxPoints);
+            pnlSeries = std::make_unique<PnlSeries>();
+        }
+
+        // Optional: save the state every Checkpoint.EveryEvents events
+        SimulationOutputs outputs{};
+        outputs.tradeSink = tradeWriter.get();
+        outputs.series = pnlSeries.get();
+        outputs.resume = resume.get();
+        outputs.inputHash = inputHash;
+        outputs.windowStart = windowStart;
+        outputs.windowEnd = windowEnd;
+        if (cfg.HasKey("Checkpoint.Path")) {
+            const long long every = cfg.HasKey("Checkpoint.EveryEvents")
+                ? cfg.GetInt64("Checkpoint.EveryEvents") : kCheckpointEveryEvents;
+            if (every <= 0) {
+                throw std::runtime_error("Checkpoint.EveryEvents must be > 0");
+            }
+            outputs.checkpointPath = cfg.GetValidatedPath("Checkpoint.Path");
+            outputs.checkpointEveryEvents = static_cast<std::uint64_t>(every);
+        }
+
+        // 4-8. Run the configured strategy over the merged timeline
+        const SimulationRun run = runStrategy(cfg, readBatch, outputs);
+        if (tradeWriter) {
+            tradeWriter->Close();
+        }
+        size_t pnlSamples = 0;
+        if (pnlSeries) {
+            // Optional: thin the series for charting, keeping PnL extremes
+            pnlSamples = pnlSeries->Size();
+            if (pnlSeriesMaxPoints > 0) {
+                *pnlSeries = DownsamplePnlSeries(*pnlSeries, pnlSeriesMaxPoints);
+            }
+            pnlSeries->WriteFile(pnlSeriesPath, pnlSeriesFormat);
+        }
 
         const auto t_total1 = Clock::now();
 
         // 9. Performance Metrics
-        const double loopMs = Ms(t_loop0, t_loop1);
+        const double loopMs = Ms(run.loopStart, run.loopEnd);
         const double totalMs = Ms(t_total0, t_total1);
-        const double loopSec = Sec(t_loop0, t_loop1);
+        const double loopSec = Sec(run.loopStart, run.loopEnd);
+        const std::uint64_t events = run.events;
 
         std::cout << "\nTiming Statistics\n";
         std::cout << "Events processed: " << events << "\n";
         std::cout << "Loop time: " << loopMs << " ms\n";
         std::cout << "Total time: " << totalMs << " ms\n";
         std::cout << "Throughput: " << (loopSec > 0.0 ? (events / loopSec) : 0.0) << " events/sec\n";
+        if (useCache) {
+            std::cout << (cacheBuilt ? "Timeline cache written: " : "Timeline cache hit: ")
+                << sources[0]->GetFilePath() << "\n";
+        }
+        if (tradeWriter) {
+            tradeWriter->PrintStats(std::cout);
+        }
+        if (resume) {
+            std::cout << "Resumed from: " << resumePath << " after event " << resume->events << "\n";
+        }
+        if (!outputs.checkpointPath.empty()) {
+            std::cout << "Checkpoints written: " << run.checkpoints << " to " << outputs.checkpointPath << "\n";
+        }
+        if (pnlSeries) {
+            std::cout << "PnL series: " << pnlSeries->Size() << " of " << pnlSamples << " samples written to "
+                << pnlSeriesPath << "\n";
+        }
+        for (const auto& source : sources) {
+            source->PrintStats(std::cout);
+        }
 #ifdef ENABLE_PER_EVENT_TIMING
-        std::cout << "Avg OnEvent: " << (events ? (onEventMsSum / events) : 0.0) << " ms\n";
+        std::cout << "Avg OnEvent: " << (events ? (run.onEventMsSum / events) : 0.0) << " ms\n";
 #endif
 
     }
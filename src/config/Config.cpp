@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
 namespace fs = std::filesystem;
@@ -80,6 +82,40 @@ int Config::GetInt(const std::string &key) const {
   return std::stoi(values_.at(key));
 }
 
+long long Config::GetInt64(const std::string &key) const {
+  if (values_.find(key) == values_.end()) {
+    throw std::runtime_error("Config: Missing key: " + key);
+  }
+  return std::stoll(values_.at(key));
+}
+
+std::vector<double> Config::GetDoubleList(const std::string &key) const {
+  std::vector<double> values;
+  std::stringstream ss(GetString(key));
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    values.push_back(std::stod(item));
+  }
+  if (values.empty()) {
+    throw std::runtime_error("Config: Empty list for key: " + key);
+  }
+  return values;
+}
+
+std::vector<int> Config::GetIntList(const std::string &key) const {
+  std::vector<int> values;
+  for (double v : GetDoubleList(key)) {
+    // Range-check first: the cast is undefined outside int (and for NaN)
+    if (!(v >= static_cast<double>(std::numeric_limits<int>::min()) &&
+          v <= static_cast<double>(std::numeric_limits<int>::max())) ||
+        v != static_cast<int>(v)) {
+      throw std::runtime_error("Config: Expected integers for key: " + key);
+    }
+    values.push_back(static_cast<int>(v));
+  }
+  return values;
+}
+
 std::string Config::GetString(const std::string &key) const {
   if (values_.find(key) == values_.end()) {
     throw std::runtime_error("Config: Missing key: " + key);
@@ -87,6 +123,10 @@ std::string Config::GetString(const std::string &key) const {
   return values_.at(key);
 }
 
+bool Config::HasKey(const std::string &key) const {
+  return values_.find(key) != values_.end();
+}
+
 void Config::SetAllowedBaseDir(const std::string &baseDir) {
   allowedBaseDir_ = fs::weakly_canonical(fs::path(baseDir)).string();
 }
@@ -154,11 +194,14 @@ bool Config::IsPathSafe(const std::string &path) const {
 }
 
 std::string Config::GetValidatedPath(const std::string &key) const {
-  std::string path = GetString(key);
+  return ValidatePath(GetString(key), key);
+}
 
+std::string Config::ValidatePath(const std::string &path,
+                                 const std::string &source) const {
   if (!IsPathSafe(path)) {
     throw std::runtime_error(
-        "Config: Path validation failed for key '" + key +
+        "Config: Path validation failed for key '" + source +
         "': path escapes allowed directory or contains invalid patterns. "
         "Path: " + path + ", Allowed base: " + allowedBaseDir_);
   }
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ArbSim {
 
@@ -10,12 +11,24 @@ public:
 
   double GetDouble(const std::string &key) const;
   int GetInt(const std::string &key) const;
+  long long GetInt64(const std::string &key) const;
   std::string GetString(const std::string &key) const;
 
+  // Comma-separated values, e.g. "Sweep.StopLossPnl=-50,-100,-200"
+  std::vector<double> GetDoubleList(const std::string &key) const;
+  std::vector<int> GetIntList(const std::string &key) const;
+
+  // True if the key is present (for optional settings)
+  bool HasKey(const std::string &key) const;
+
   // Returns a validated file path that is guaranteed to be within the allowed
   // base directory. Throws std::runtime_error if path escapes the base or
   // contains suspicious patterns.
   std::string GetValidatedPath(const std::string &key) const;
+  // Same check for a path that is not a config value (e.g. read from a file
+  // named in the config); `source` names it in the error
+  std::string ValidatePath(const std::string &path,
+                           const std::string &source) const;
 
   // Sets the base directory for path validation. Defaults to current working
   // directory.
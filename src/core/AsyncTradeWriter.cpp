@@ -0,0 +1,162 @@
+#include "AsyncTradeWriter.h"
+
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace ArbSim {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Bytes the writer collects before each file write
+constexpr size_t kWriteChunk = 64 * 1024;
+// Writer back-off while the ring is empty; the ring absorbs the fills
+// arriving meanwhile
+constexpr auto kIdleSleep = std::chrono::microseconds(200);
+
+TradeLogHeader MakeHeader(uint64_t count) {
+  TradeLogHeader header{};
+  std::memcpy(header.magic, kTradeLogMagic, sizeof(header.magic));
+  header.version = kTradeLogVersion;
+  header.recordSize = sizeof(TradeRecord);
+  header.count = count;
+  return header;
+}
+
+} // namespace
+
+AsyncTradeWriter::AsyncTradeWriter(const std::string &filePath,
+                                   TradeLogFormat format, size_t ringRecords)
+    : filePath_(filePath), format_(format),
+      file_(filePath, std::ios::binary | std::ios::trunc), ring_(ringRecords),
+      stop_(false), closed_(false), count_(0), fullStalls_(0),
+      fullStallNs_(0), written_(0) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("AsyncTradeWriter: Failed to create file: " +
+                             filePath_);
+  }
+  if (format_ == TradeLogFormat::Binary) {
+    // Placeholder, rewritten by Close() once the count is known
+    const TradeLogHeader header = MakeHeader(0);
+    file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  writer_ = std::thread(&AsyncTradeWriter::WriterLoop, this);
+}
+
+AsyncTradeWriter::~AsyncTradeWriter() {
+  try {
+    Close();
+  } catch (...) {
+    // Destructors must not throw; call Close() explicitly to see errors
+  }
+}
+
+void AsyncTradeWriter::OnTrade(const TradeRecord &trade) {
+  if (closed_) {
+    throw std::runtime_error("AsyncTradeWriter: OnTrade after Close: " +
+                             filePath_);
+  }
+  TradeRecord *slot = ring_.BeginPush();
+  if (slot == nullptr) {
+    ++fullStalls_;
+    const auto t0 = Clock::now();
+    while ((slot = ring_.BeginPush()) == nullptr) {
+      std::this_thread::yield();
+    }
+    fullStallNs_ += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             t0)
+            .count());
+  }
+  *slot = trade;
+  ring_.CommitPush();
+  ++count_;
+}
+
+void AsyncTradeWriter::WriterLoop() {
+  std::vector<char> chunk;
+  chunk.reserve(kWriteChunk + 256); // room for one more line past the limit
+  const auto flush = [&]() {
+    if (!chunk.empty()) {
+      file_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      chunk.clear();
+    }
+  };
+
+  for (;;) {
+    const TradeRecord *trade = ring_.Front();
+    if (trade == nullptr) {
+      flush();
+      if (!stop_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(kIdleSleep);
+        continue;
+      }
+      // Close() publishes the last record before stop_; look once more
+      trade = ring_.Front();
+      if (trade == nullptr) {
+        break;
+      }
+    }
+
+    if (format_ == TradeLogFormat::Binary) {
+      const char *bytes = reinterpret_cast<const char *>(trade);
+      chunk.insert(chunk.end(), bytes, bytes + sizeof(TradeRecord));
+    } else {
+      char line[160];
+      const size_t n = FormatTrade(*trade, line, sizeof(line));
+      chunk.insert(chunk.end(), line, line + n);
+      chunk.push_back('\n');
+    }
+    ring_.Pop();
+    ++written_;
+
+    if (chunk.size() >= kWriteChunk) {
+      flush();
+    }
+  }
+}
+
+void AsyncTradeWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+
+  stop_.store(true, std::memory_order_release);
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  if (format_ == TradeLogFormat::Binary) {
+    const TradeLogHeader header = MakeHeader(written_);
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  file_.close();
+  if (file_.fail()) {
+    throw std::runtime_error("AsyncTradeWriter: Failed to write file: " +
+                             filePath_);
+  }
+}
+
+size_t AsyncTradeWriter::GetPeakMemoryBytes() const {
+  return ring_.Capacity() * sizeof(TradeRecord) + kWriteChunk + 256;
+}
+
+const std::string &AsyncTradeWriter::GetFilePath() const { return filePath_; }
+
+uint64_t AsyncTradeWriter::GetCount() const { return count_; }
+
+uint64_t AsyncTradeWriter::GetFullStalls() const { return fullStalls_; }
+
+void AsyncTradeWriter::PrintStats(std::ostream &out) const {
+  out << "Trade log " << filePath_ << ": " << count_
+      << " trades, ring full stalls " << fullStalls_ << " ("
+      << fullStallNs_ / 1e6 << " ms)\n";
+}
+
+} // namespace ArbSim
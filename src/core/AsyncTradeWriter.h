@@ -0,0 +1,77 @@
+#ifndef ASYNC_TRADE_WRITER_H
+#define ASYNC_TRADE_WRITER_H
+
+#include "SpscRing.h"
+#include "TradeLog.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <thread>
+
+namespace ArbSim {
+
+enum class TradeLogFormat {
+  Text,   // one FormatTrade() line per fill, as printed to stdout
+  Binary, // TradeLogHeader + TradeRecords (ReadTradeLogFile)
+};
+
+// Trade sink that hands each fill to a background writer thread through a
+// bounded SPSC ring of TradeRecords. The simulation thread only copies the
+// 32-byte record into the ring; formatting and file I/O happen on the writer,
+// which drains the ring in chunks and sleeps while it is empty.
+//
+// Memory stays at ringRecords * 32 bytes: when the ring is full, OnTrade()
+// waits for a free slot (counted as a full stall). Close() drains the ring,
+// stops the writer and finalizes the file.
+class AsyncTradeWriter : public ITradeSink {
+public:
+  static constexpr size_t kDefaultRingRecords = 1 << 16; // 2MB of records
+
+  // ringRecords must be a power of two (SpscRing)
+  AsyncTradeWriter(const std::string &filePath, TradeLogFormat format,
+                   size_t ringRecords = kDefaultRingRecords);
+  ~AsyncTradeWriter() override;
+
+  AsyncTradeWriter(const AsyncTradeWriter &) = delete;
+  AsyncTradeWriter &operator=(const AsyncTradeWriter &) = delete;
+
+  void OnTrade(const TradeRecord &trade) override;
+  // The ring plus the writer's chunk buffer: fixed at construction
+  size_t GetPeakMemoryBytes() const override;
+
+  // Writes every pending record and closes the file; throws
+  // std::runtime_error on write errors. The destructor closes if needed.
+  void Close();
+
+  const std::string &GetFilePath() const;
+  uint64_t GetCount() const;
+  uint64_t GetFullStalls() const;
+  void PrintStats(std::ostream &out) const;
+
+private:
+  std::string filePath_;
+  const TradeLogFormat format_;
+  std::ofstream file_;
+  SpscRing<TradeRecord> ring_;
+
+  std::atomic<bool> stop_;
+  bool closed_;
+
+  // Producer-side counters
+  uint64_t count_;
+  uint64_t fullStalls_;
+  uint64_t fullStallNs_;
+  // Written by the writer thread, read after it joined
+  uint64_t written_;
+
+  std::thread writer_;
+
+  void WriterLoop();
+};
+
+} // namespace ArbSim
+
+#endif // ASYNC_TRADE_WRITER_H
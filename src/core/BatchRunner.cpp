@@ -0,0 +1,210 @@
+#include "BatchRunner.h"
+
+#include "Constants.h"
+#include "EventSourceFactory.h"
+#include "MarketData.h"
+#include "PnlTracker.h"
+#include "PrefetchingEventSource.h"
+#include "SimulationEngine.h"
+#include "Strategy.h"
+#include "StreamMerger.h"
+#include "TradeLog.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+
+namespace ArbSim {
+
+namespace {
+
+std::string Trim(const std::string &s) {
+  const size_t first = s.find_first_not_of(" \t\r");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  const size_t last = s.find_last_not_of(" \t\r");
+  return s.substr(first, last - first + 1);
+}
+
+BatchDayResult RunDay(const BatchDay &day, const StrategyParams &params,
+                      const BatchDataOptions &data) {
+  std::unique_ptr<IEventSource> readerA =
+      OpenEventSource(day.futureA, data.parsePool);
+  std::unique_ptr<IEventSource> readerB =
+      OpenEventSource(day.futureB, data.parsePool);
+  if (data.startTime != std::numeric_limits<long long>::min()) {
+    readerA->SeekToTime(data.startTime);
+    readerB->SeekToTime(data.startTime);
+  }
+  if (data.prefetch) {
+    readerA = std::make_unique<PrefetchingEventSource>(std::move(readerA));
+    readerB = std::make_unique<PrefetchingEventSource>(std::move(readerB));
+  }
+  StreamMerger merger(*readerA, *readerB, kMergeSeed);
+  merger.SetTimeWindow(data.startTime, data.endTime);
+
+  // A day's trades are only counted
+  CountingTradeSink trades;
+  SimulationEngine engine(Strategy(params), PnlTracker(), trades);
+
+  std::vector<MarketEvent> batch(kEventBatchSize);
+  uint64_t events = 0;
+  long long lastTime = 0;
+  size_t count = 0;
+  while (!engine.IsStopped() &&
+         (count = merger.ReadBatch(batch.data(), batch.size())) > 0) {
+    const size_t done = engine.OnEvents(batch.data(), count);
+    events += done;
+    lastTime = batch[done - 1].sendingTime;
+  }
+  engine.OnEndOfDay(lastTime);
+
+  const PnlTracker &pnl = engine.GetPnl();
+  BatchDayResult result{};
+  result.day = day;
+  result.events = events;
+  result.trades = trades.GetCount();
+  result.stopped = engine.IsStopped();
+  result.totalPnlTicks = pnl.GetTotalPnlTicks();
+  result.totalPnl = pnl.GetTotalPnl();
+  result.bestPnl = pnl.GetBestPnl();
+  result.worstPnl = pnl.GetWorstPnl();
+  result.maxExposure = pnl.GetMaxAbsExposure();
+  result.tradedLots = pnl.GetTradedLots();
+  result.droppedBuys = engine.GetDroppedBuyCount();
+  result.droppedSells = engine.GetDroppedSellCount();
+  return result;
+}
+
+} // namespace
+
+std::vector<BatchDay> ReadBatchManifest(const std::string &filePath) {
+  std::ifstream file(filePath);
+  if (!file.is_open()) {
+    throw std::runtime_error("ReadBatchManifest: Failed to open file: " +
+                             filePath);
+  }
+
+  std::vector<BatchDay> days;
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    line = Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    const size_t comma = line.find(',');
+    BatchDay day;
+    if (comma != std::string::npos) {
+      day.futureA = Trim(line.substr(0, comma));
+      day.futureB = Trim(line.substr(comma + 1));
+    }
+    if (day.futureA.empty() || day.futureB.empty() ||
+        day.futureB.find(',') != std::string::npos) {
+      throw std::runtime_error(
+          "ReadBatchManifest: Expected '<FutureA>,<FutureB>' at line " +
+          std::to_string(lineNumber) + " of " + filePath);
+    }
+    days.push_back(day);
+  }
+  return days;
+}
+
+std::vector<BatchDayResult> RunBatch(const std::vector<BatchDay> &days,
+                                     const StrategyParams &params,
+                                     ThreadPool &pool,
+                                     const BatchDataOptions &data) {
+  // One task per day; the pool's size bounds how many run at once
+  std::vector<std::future<BatchDayResult>> pending;
+  pending.reserve(days.size());
+  for (const BatchDay &day : days) {
+    pending.push_back(pool.Submit([&day, &params, &data]() {
+      try {
+        return RunDay(day, params, data);
+      } catch (const std::exception &e) {
+        BatchDayResult failed{};
+        failed.day = day;
+        failed.error = e.what();
+        return failed;
+      }
+    }));
+  }
+
+  std::vector<BatchDayResult> results;
+  results.reserve(days.size());
+  for (std::future<BatchDayResult> &f : pending) {
+    results.push_back(f.get());
+  }
+  return results;
+}
+
+BatchTotal SumBatch(const std::vector<BatchDayResult> &results) {
+  BatchTotal total{};
+  int64_t totalPnlTicks = 0;
+  for (const BatchDayResult &r : results) {
+    if (!r.error.empty()) {
+      ++total.failedDays;
+      continue;
+    }
+    total.bestDayPnl =
+        total.days == 0 ? r.totalPnl : std::max(total.bestDayPnl, r.totalPnl);
+    total.worstDayPnl =
+        total.days == 0 ? r.totalPnl : std::min(total.worstDayPnl, r.totalPnl);
+    ++total.days;
+    total.stoppedDays += r.stopped ? 1 : 0;
+    total.events += r.events;
+    total.trades += r.trades;
+    totalPnlTicks += r.totalPnlTicks;
+    total.maxExposure = std::max(total.maxExposure, r.maxExposure);
+    total.tradedLots += r.tradedLots;
+    total.droppedBuys += r.droppedBuys;
+    total.droppedSells += r.droppedSells;
+  }
+  total.totalPnl = TicksToPrice(totalPnlTicks);
+  return total;
+}
+
+void WriteBatchCsv(std::ostream &out,
+                   const std::vector<BatchDayResult> &results) {
+  out << "FutureA,FutureB,Events,Trades,Stopped,TotalPnl,BestPnl,WorstPnl,"
+         "MaxExposure,TradedLots,DroppedBuys,DroppedSells,Error\n";
+  for (const BatchDayResult &r : results) {
+    out << r.day.futureA << ',' << r.day.futureB << ',';
+    if (!r.error.empty()) {
+      // Quoted: messages can hold commas
+      std::string quoted = r.error;
+      for (size_t pos = 0; (pos = quoted.find('"', pos)) != std::string::npos;
+           pos += 2) {
+        quoted.insert(pos, 1, '"');
+      }
+      out << ",,,,,,,,,,\"" << quoted << "\"\n";
+      continue;
+    }
+    out << r.events << ',' << r.trades << ',' << (r.stopped ? 1 : 0) << ','
+        << r.totalPnl << ',' << r.bestPnl << ',' << r.worstPnl << ','
+        << r.maxExposure << ',' << r.tradedLots << ',' << r.droppedBuys << ','
+        << r.droppedSells << ",\n";
+  }
+}
+
+void PrintBatchTotal(std::ostream &out, const BatchTotal &total) {
+  out << "Batch finished\n";
+  out << "Days: " << total.days << " (" << total.stoppedDays
+      << " stopped, " << total.failedDays << " failed)\n";
+  out << "Total PnL: " << total.totalPnl << "\n";
+  out << "Best day PnL: " << total.bestDayPnl << "\n";
+  out << "Worst day PnL: " << total.worstDayPnl << "\n";
+  out << "Max exposure: " << total.maxExposure << "\n";
+  out << "Traded lots: " << total.tradedLots << "\n";
+  out << "Trades: " << total.trades << "\n";
+  out << "Dropped buys: " << total.droppedBuys << "\n";
+  out << "Dropped sells: " << total.droppedSells << "\n";
+}
+
+} // namespace ArbSim
@@ -0,0 +1,95 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "StrategyParams.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+// One trading day: the FutureA and FutureB files replayed together
+struct BatchDay {
+  std::string futureA;
+  std::string futureB;
+};
+
+// Reads a batch manifest: one day per line as "<FutureA path>,<FutureB path>",
+// in the order the days should be reported. Blank lines and lines starting
+// with '#' are skipped. Throws std::runtime_error if the file cannot be read
+// or a line is not a pair.
+std::vector<BatchDay> ReadBatchManifest(const std::string &filePath);
+
+// Outcome of one day (PrintSummary fields), or the error that stopped it
+struct BatchDayResult {
+  BatchDay day;
+  std::string error; // empty when the day ran
+  uint64_t events;
+  uint64_t trades;
+  bool stopped;
+  int64_t totalPnlTicks;
+  double totalPnl;
+  double bestPnl;
+  double worstPnl;
+  int maxExposure;
+  int tradedLots;
+  size_t droppedBuys;
+  size_t droppedSells;
+};
+
+// How each day's inputs are read, as for a single replay (Data.* keys)
+struct BatchDataOptions {
+  // Only startTime <= sendingTime < endTime is replayed; readers seek to
+  // startTime first
+  long long startTime = std::numeric_limits<long long>::min();
+  long long endTime = std::numeric_limits<long long>::max();
+  // Plain CSV inputs are parsed in parallel chunks on it (optional; must not
+  // be the pool the days run on)
+  ThreadPool *parsePool = nullptr;
+  // Each input is parsed ahead on its own PrefetchingEventSource thread
+  bool prefetch = false;
+};
+
+// Runs every day independently on the pool (StreamMerger + SimulationEngine
+// with a fresh Strategy and PnlTracker each, including the end-of-day close),
+// so at most pool.Size() days are in flight. Trades are counted, not logged.
+// A day that throws (e.g. a missing file) gets its error recorded and the
+// others still run. Results come back in manifest order.
+std::vector<BatchDayResult> RunBatch(const std::vector<BatchDay> &days,
+                                     const StrategyParams &params,
+                                     ThreadPool &pool,
+                                     const BatchDataOptions &data = {});
+
+// Portfolio over the days that ran: PnL and lots add up, extremes are per day
+struct BatchTotal {
+  size_t days;
+  size_t failedDays;
+  size_t stoppedDays;
+  uint64_t events;
+  uint64_t trades;
+  double totalPnl; // summed in ticks
+  double bestDayPnl;
+  double worstDayPnl;
+  int maxExposure;
+  int tradedLots;
+  size_t droppedBuys;
+  size_t droppedSells;
+};
+
+BatchTotal SumBatch(const std::vector<BatchDayResult> &results);
+
+// One CSV row per day, with a header line; failed days carry their error
+void WriteBatchCsv(std::ostream &out,
+                   const std::vector<BatchDayResult> &results);
+
+// The portfolio lines printed after a batch
+void PrintBatchTotal(std::ostream &out, const BatchTotal &total);
+
+} // namespace ArbSim
+
+#endif // BATCH_RUNNER_H
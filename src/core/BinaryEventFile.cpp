@@ -0,0 +1,240 @@
+#include "BinaryEventFile.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace ArbSim {
+
+namespace {
+
+BinaryEventHeader MakeEmptyHeader() {
+  BinaryEventHeader header{};
+  std::memcpy(header.magic, kBinaryEventMagic, sizeof(header.magic));
+  header.version = kBinaryEventVersion;
+  header.recordSize = sizeof(BinaryEventRecord);
+  header.instrument = static_cast<uint8_t>(InstrumentId::Unknown);
+  return header;
+}
+
+bool IsValidInstrumentByte(uint8_t instrument) {
+  return instrument <= static_cast<uint8_t>(InstrumentId::Unknown);
+}
+
+// False (event untouched) if the record holds an out-of-range instrument
+bool RecordToEvent(const BinaryEventRecord &rec, bool doublePrices,
+                   MarketEvent &event) {
+  if (!IsValidInstrumentByte(rec.instrument)) {
+    return false;
+  }
+  event.sendingTime = rec.sendingTime;
+  event.instrumentId = static_cast<InstrumentId>(rec.instrument);
+  event.eventTypeId = rec.eventTypeId;
+  event.bidSize = rec.bidSize;
+  event.askSize = rec.askSize;
+  if (doublePrices) {
+    double bid;
+    double ask;
+    std::memcpy(&bid, &rec.bidTicks, sizeof(bid));
+    std::memcpy(&ask, &rec.askTicks, sizeof(ask));
+    event.bidTicks = PriceToTicks(bid);
+    event.askTicks = PriceToTicks(ask);
+  } else {
+    event.bidTicks = rec.bidTicks;
+    event.askTicks = rec.askTicks;
+  }
+  return true;
+}
+
+[[noreturn]] void ThrowBadInstrument(const std::string &filePath,
+                                     uint64_t index) {
+  throw std::runtime_error("BinaryEventReader: Invalid instrument in record " +
+                           std::to_string(index) + " of: " + filePath);
+}
+
+} // namespace
+
+bool IsBinaryEventFile(const std::string &filePath) {
+  std::ifstream f(filePath, std::ios::binary);
+  char magic[sizeof(kBinaryEventMagic)] = {};
+  if (!f.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return std::memcmp(magic, kBinaryEventMagic, sizeof(magic)) == 0;
+}
+
+// --- Writer ---
+
+BinaryEventWriter::BinaryEventWriter(const std::string &filePath)
+    : filePath_(filePath), file_(filePath, std::ios::binary | std::ios::trunc),
+      header_(MakeEmptyHeader()), closed_(false) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("BinaryEventWriter: Failed to create file: " +
+                             filePath_);
+  }
+  // Placeholder, rewritten by Close() once count and time range are known
+  file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+}
+
+BinaryEventWriter::~BinaryEventWriter() {
+  try {
+    Close();
+  } catch (...) {
+    // Destructors must not throw; call Close() explicitly to see errors
+  }
+}
+
+void BinaryEventWriter::Write(const MarketEvent &event) {
+  BinaryEventRecord rec{};
+  rec.sendingTime = event.sendingTime;
+  rec.bidTicks = event.bidTicks;
+  rec.askTicks = event.askTicks;
+  rec.bidSize = event.bidSize;
+  rec.askSize = event.askSize;
+  rec.eventTypeId = event.eventTypeId;
+  rec.instrument = static_cast<uint8_t>(event.instrumentId);
+
+  if (header_.count == 0) {
+    header_.firstTime = event.sendingTime;
+    header_.instrument = rec.instrument;
+  } else if (header_.instrument != rec.instrument) {
+    header_.instrument = static_cast<uint8_t>(InstrumentId::Unknown);
+  }
+  header_.lastTime = event.sendingTime;
+  ++header_.count;
+
+  file_.write(reinterpret_cast<const char *>(&rec), sizeof(rec));
+}
+
+void BinaryEventWriter::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  file_.close();
+  if (file_.fail()) {
+    throw std::runtime_error("BinaryEventWriter: Failed to write file: " +
+                             filePath_);
+  }
+}
+
+uint64_t BinaryEventWriter::GetCount() const { return header_.count; }
+
+// --- Reader ---
+
+BinaryEventReader::BinaryEventReader(const std::string &filePath)
+    : filePath_(filePath), header_{}, records_(nullptr), next_(0),
+      doublePrices_(false) {
+  try {
+    mapped_ = std::make_unique<MappedFile>(filePath_);
+  } catch (const std::runtime_error &) {
+    throw std::runtime_error("BinaryEventReader: Failed to open file: " +
+                             filePath_);
+  }
+
+  if (mapped_->Size() < sizeof(BinaryEventHeader)) {
+    throw std::runtime_error("BinaryEventReader: File too small for header: " +
+                             filePath_);
+  }
+  std::memcpy(&header_, mapped_->Data(), sizeof(header_));
+
+  if (std::memcmp(header_.magic, kBinaryEventMagic, sizeof(header_.magic)) !=
+      0) {
+    throw std::runtime_error("BinaryEventReader: Bad magic in: " + filePath_);
+  }
+  if (header_.version != kBinaryEventVersion && header_.version != 1) {
+    throw std::runtime_error("BinaryEventReader: Unsupported version " +
+                             std::to_string(header_.version) + " in: " +
+                             filePath_);
+  }
+  if (header_.recordSize != sizeof(BinaryEventRecord)) {
+    throw std::runtime_error("BinaryEventReader: Unexpected record size " +
+                             std::to_string(header_.recordSize) + " in: " +
+                             filePath_);
+  }
+
+  if (!IsValidInstrumentByte(header_.instrument)) {
+    throw std::runtime_error("BinaryEventReader: Invalid header instrument in: " +
+                             filePath_);
+  }
+
+  // Bound count before multiplying so a corrupt header cannot wrap
+  const uint64_t maxCount = (mapped_->Size() - sizeof(BinaryEventHeader)) /
+                            sizeof(BinaryEventRecord);
+  if (header_.count > maxCount) {
+    throw std::runtime_error(
+        "BinaryEventReader: Record count " + std::to_string(header_.count) +
+        " exceeds file size (" + std::to_string(mapped_->Size()) +
+        " bytes) in: " + filePath_);
+  }
+  const uint64_t expectedSize =
+      sizeof(BinaryEventHeader) + header_.count * sizeof(BinaryEventRecord);
+  if (mapped_->Size() != expectedSize) {
+    throw std::runtime_error(
+        "BinaryEventReader: File size does not match record count (" +
+        std::to_string(mapped_->Size()) + " bytes, expected " +
+        std::to_string(expectedSize) + ") in: " + filePath_);
+  }
+
+  doublePrices_ = header_.version == 1;
+
+  mapped_->AdviseSequential();
+  records_ = reinterpret_cast<const BinaryEventRecord *>(
+      mapped_->Data() + sizeof(BinaryEventHeader));
+}
+
+const std::string &BinaryEventReader::GetFilePath() const { return filePath_; }
+
+const BinaryEventHeader &BinaryEventReader::GetHeader() const {
+  return header_;
+}
+
+size_t BinaryEventReader::ReadEvents(MarketEvent *out, size_t max) {
+  const uint64_t left = header_.count - next_;
+  const size_t n = left < max ? static_cast<size_t>(left) : max;
+  for (size_t i = 0; i < n; ++i) {
+    BinaryEventRecord rec;
+    std::memcpy(&rec, records_ + next_ + i, sizeof(rec));
+    if (!RecordToEvent(rec, doublePrices_, out[i])) {
+      ThrowBadInstrument(filePath_, next_ + i);
+    }
+  }
+  next_ += n;
+  return n;
+}
+
+bool BinaryEventReader::SeekToTime(long long time) {
+  // First record with sendingTime >= time
+  uint64_t lo = 0;
+  uint64_t hi = header_.count;
+  while (lo < hi) {
+    const uint64_t mid = lo + (hi - lo) / 2;
+    int64_t t;
+    std::memcpy(&t, &records_[mid].sendingTime, sizeof(t));
+    if (t < time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  next_ = lo;
+  return true;
+}
+
+bool BinaryEventReader::ReadNextEvent(MarketEvent &event) {
+  if (next_ >= header_.count) {
+    return false;
+  }
+
+  BinaryEventRecord rec;
+  std::memcpy(&rec, records_ + next_, sizeof(rec));
+  if (!RecordToEvent(rec, doublePrices_, event)) {
+    ThrowBadInstrument(filePath_, next_);
+  }
+  ++next_;
+  return true;
+}
+
+} // namespace ArbSim
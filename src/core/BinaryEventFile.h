@@ -0,0 +1,102 @@
+#ifndef BINARY_EVENT_FILE_H
+#define BINARY_EVENT_FILE_H
+
+#include "IEventSource.h"
+#include "MappedFile.h"
+#include "MarketData.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace ArbSim {
+
+// Compact fixed-width event file: one header followed by `count` records.
+// Fields are stored in host (little-endian) byte order; files are meant to
+// be produced and replayed on the same kind of machine.
+//
+//   [BinaryEventHeader][BinaryEventRecord x count]
+constexpr char kBinaryEventMagic[8] = {'A', 'R', 'B', 'S', 'I', 'M', 'E', 'V'};
+//
+// Version 2 stores prices as int64 ticks (MarketEvent::bidTicks/askTicks).
+// Version 1 files, which hold the same layout with double prices, are still
+// read and converted.
+constexpr uint32_t kBinaryEventVersion = 2;
+
+struct BinaryEventHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t count;
+  int64_t firstTime; // sendingTime of the first record (0 if empty)
+  int64_t lastTime;  // sendingTime of the last record (0 if empty)
+  uint8_t instrument; // InstrumentId of all records, Unknown if mixed
+  uint8_t reserved[23];
+};
+
+struct BinaryEventRecord {
+  int64_t sendingTime;
+  int64_t bidTicks; // double price in version 1
+  int64_t askTicks; // double price in version 1
+  int32_t bidSize;
+  int32_t askSize;
+  int32_t eventTypeId;
+  uint8_t instrument;
+  uint8_t reserved[3];
+};
+
+static_assert(sizeof(BinaryEventHeader) == 64, "BinaryEventHeader layout");
+static_assert(sizeof(BinaryEventRecord) == 40, "BinaryEventRecord layout");
+
+// True if the file at path starts with kBinaryEventMagic
+bool IsBinaryEventFile(const std::string &filePath);
+
+// Streams events to a binary event file. The header (count, time range,
+// instrument) is finalized by Close(); the destructor closes if needed.
+class BinaryEventWriter {
+public:
+  explicit BinaryEventWriter(const std::string &filePath);
+  ~BinaryEventWriter();
+
+  BinaryEventWriter(const BinaryEventWriter &) = delete;
+  BinaryEventWriter &operator=(const BinaryEventWriter &) = delete;
+
+  void Write(const MarketEvent &event);
+  void Close();
+
+  uint64_t GetCount() const;
+
+private:
+  std::string filePath_;
+  std::ofstream file_;
+  BinaryEventHeader header_;
+  bool closed_;
+};
+
+// Replays a binary event file through a read-only mapping; events are
+// copied out of the records with no parsing.
+class BinaryEventReader : public IEventSource {
+public:
+  explicit BinaryEventReader(const std::string &filePath);
+
+  const std::string &GetFilePath() const override;
+  bool ReadNextEvent(MarketEvent &event) override;
+  size_t ReadEvents(MarketEvent *out, size_t max) override;
+  // Binary search over the fixed-width records; no index needed
+  bool SeekToTime(long long time) override;
+
+  const BinaryEventHeader &GetHeader() const;
+
+private:
+  std::string filePath_;
+  std::unique_ptr<MappedFile> mapped_;
+  BinaryEventHeader header_;
+  const BinaryEventRecord *records_;
+  uint64_t next_;
+  bool doublePrices_; // version 1 file
+};
+
+} // namespace ArbSim
+
+#endif // BINARY_EVENT_FILE_H
@@ -0,0 +1,87 @@
+#ifndef BUFFERED_INPUT_H
+#define BUFFERED_INPUT_H
+
+#include "IEventSource.h"
+#include "MarketData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ArbSim {
+
+// Block of events read ahead from one source, as consumed by the mergers.
+// Only events inside [startTime, endTime) are kept; sources are time-sorted,
+// so the first event at or after endTime closes the input.
+struct BufferedInput {
+  BufferedInput(IEventSource &source, size_t blockEvents)
+      : reader(&source), events(blockEvents), pos(0), count(0), done(false),
+        lastTime(std::numeric_limits<long long>::min()), lastRun(0) {}
+
+  IEventSource *reader;
+  std::vector<MarketEvent> events;
+  size_t pos;
+  size_t count;
+  bool done; // reader exhausted or past the window end
+
+  // sendingTime of the last event taken and how many were taken at it
+  long long lastTime;
+  uint64_t lastRun;
+
+  bool HasEvent() const { return pos < count; }
+  const MarketEvent &Head() const { return events[pos]; }
+
+  // Ordinal of Head() among this source's events at its sendingTime, the
+  // per-source part of the tie-break key (TieBreak.h)
+  uint64_t HeadOrdinal() const {
+    return Head().sendingTime == lastTime ? lastRun : 0;
+  }
+
+  // Consumes Head(); valid until the next Refill()
+  const MarketEvent &Take() {
+    const MarketEvent &e = events[pos++];
+    if (e.sendingTime == lastTime) {
+      ++lastRun;
+    } else {
+      lastTime = e.sendingTime;
+      lastRun = 1;
+    }
+    return e;
+  }
+
+  // Makes Head() valid if the buffer ran out; false once exhausted
+  bool Refill(long long startTime, long long endTime) {
+    while (!done) {
+      const size_t n = reader->ReadEvents(events.data(), events.size());
+      if (n == 0) {
+        done = true;
+        break;
+      }
+
+      size_t kept = 0;
+      for (size_t i = 0; i < n; ++i) {
+        const long long t = events[i].sendingTime;
+        if (t < startTime) {
+          continue;
+        }
+        if (t >= endTime) {
+          done = true;
+          break;
+        }
+        events[kept++] = events[i];
+      }
+
+      pos = 0;
+      count = kept;
+      if (kept > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace ArbSim
+
+#endif // BUFFERED_INPUT_H
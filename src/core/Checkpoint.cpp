@@ -0,0 +1,102 @@
+#include "Checkpoint.h"
+
+#include "TieBreak.h"
+#include "TimelineCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+namespace ArbSim {
+
+uint64_t CheckpointInputHash(const std::vector<std::string> &paths) {
+  // Order matters: (a, b) and (b, a) differ
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (const std::string &path : paths) {
+    h = TieBreakMix(h ^ TimelineCache::HashFile(path));
+  }
+  return h;
+}
+
+CheckpointSchedule::CheckpointSchedule(uint64_t everyEvents, uint64_t events)
+    : everyEvents_(everyEvents),
+      nextEvent_(everyEvents > 0 ? events + everyEvents
+                                 : std::numeric_limits<uint64_t>::max()) {}
+
+bool CheckpointSchedule::IsDue(uint64_t events, long long nextTime,
+                               long long lastTime) const {
+  return events >= nextEvent_ && nextTime != lastTime;
+}
+
+void CheckpointSchedule::Taken(uint64_t events) {
+  nextEvent_ = events + everyEvents_;
+}
+
+uint64_t CheckpointSchedule::EventsUntilDue(uint64_t events) const {
+  // Once due, the checkpoint waits for the next timestamp one event at a
+  // time
+  return nextEvent_ > events ? nextEvent_ - events : 1;
+}
+
+void WriteCheckpointFile(const std::string &filePath,
+                         const Checkpoint &checkpoint) {
+  const std::string tmpPath = filePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      throw std::runtime_error("WriteCheckpointFile: Failed to create file: " +
+                               tmpPath);
+    }
+    CheckpointHeader header{};
+    std::memcpy(header.magic, kCheckpointMagic, sizeof(header.magic));
+    header.version = kCheckpointVersion;
+    header.size = sizeof(Checkpoint);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(&checkpoint), sizeof(checkpoint));
+    file.flush();
+    if (!file) {
+      throw std::runtime_error("WriteCheckpointFile: Failed to write file: " +
+                               tmpPath);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, filePath, ec);
+  if (ec) {
+    throw std::runtime_error("WriteCheckpointFile: Failed to replace " +
+                             filePath + ": " + ec.message());
+  }
+}
+
+Checkpoint ReadCheckpointFile(const std::string &filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("ReadCheckpointFile: Failed to open file: " +
+                             filePath);
+  }
+
+  CheckpointHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kCheckpointMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("ReadCheckpointFile: Not a checkpoint: " +
+                             filePath);
+  }
+  if (header.version != kCheckpointVersion ||
+      header.size != sizeof(Checkpoint)) {
+    throw std::runtime_error("ReadCheckpointFile: Unsupported version " +
+                             std::to_string(header.version) + " in: " +
+                             filePath);
+  }
+
+  Checkpoint checkpoint{};
+  if (!file.read(reinterpret_cast<char *>(&checkpoint), sizeof(checkpoint))) {
+    throw std::runtime_error("ReadCheckpointFile: Truncated checkpoint: " +
+                             filePath);
+  }
+  return checkpoint;
+}
+
+} // namespace ArbSim
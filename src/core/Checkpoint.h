@@ -0,0 +1,102 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "MarketData.h"
+#include "PnlTracker.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+// Everything a SimulationEngine holds besides its strategy (which is only
+// parameters): the PnL, the as-of quotes, the stop flag and the counters
+struct EngineState {
+  PnlTrackerState pnl;
+  MarketEvent lastQuoteA;
+  MarketEvent lastQuoteB;
+  uint64_t tradeSequence;
+  uint64_t droppedBuys;
+  uint64_t droppedSells;
+  uint8_t hasA;
+  uint8_t hasB;
+  uint8_t stopped;
+  uint8_t reserved[5];
+};
+
+static_assert(sizeof(EngineState) == 168, "EngineState layout");
+
+// A replay stopped right after the last event of a timestamp. The mergers
+// hold no state across timestamps (TieBreak.h), so the replay resumes
+// exactly by restoring the engine and reading the inputs again from
+// lastTime + 1, seeking through their time index (IEventSource::SeekToTime).
+struct Checkpoint {
+  EngineState engine;
+  uint64_t inputHash;   // CheckpointInputHash() of the replayed files
+  int64_t startTime;    // configured replay window [startTime, endTime)
+  int64_t endTime;
+  uint64_t events;      // merged events consumed so far
+  int64_t lastTime;     // sendingTime of the last one
+  int64_t nextSampleTime;   // PnL sampling position (Main.cpp)
+  uint64_t nextSampleEvent;
+};
+
+static_assert(sizeof(Checkpoint) == 224, "Checkpoint layout");
+
+// When a replay takes its periodic checkpoints: once everyEvents merged
+// events have been consumed since the last one (or the start), at the next
+// change of timestamp, so the checkpoint always falls between two
+// timestamps. everyEvents == 0 never checkpoints.
+class CheckpointSchedule {
+public:
+  explicit CheckpointSchedule(uint64_t everyEvents, uint64_t events = 0);
+
+  // True if a checkpoint should be taken before an event at nextTime, after
+  // `events` events of which the last was at lastTime
+  bool IsDue(uint64_t events, long long nextTime, long long lastTime) const;
+  // Starts the next interval after a checkpoint at `events`
+  void Taken(uint64_t events);
+  // Events that can run before IsDue() must be asked again (at least 1)
+  uint64_t EventsUntilDue(uint64_t events) const;
+
+private:
+  uint64_t everyEvents_;
+  uint64_t nextEvent_;
+};
+
+// Checkpoint file: one header, then the Checkpoint, in host byte order
+// (same conventions as BinaryEventFile.h)
+constexpr char kCheckpointMagic[8] = {'A', 'R', 'B', 'S', 'I', 'M', 'C', 'K'};
+//
+// Version 2 keys the inputs on their contents and records the time window.
+// Version 3 follows the per-event tie-break keys (TieBreak.h), which change
+// the merged order a checkpoint was taken in.
+constexpr uint32_t kCheckpointVersion = 3;
+
+struct CheckpointHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t size; // sizeof(Checkpoint)
+  uint8_t reserved[16];
+};
+
+static_assert(sizeof(CheckpointHeader) == 32, "CheckpointHeader layout");
+
+// Hash of the input files' contents (TimelineCache::HashFile), in order, so
+// a checkpoint is not resumed over other or changed data. Reads every file
+// once.
+uint64_t CheckpointInputHash(const std::vector<std::string> &paths);
+
+// Writes filePath + ".tmp" and renames it over filePath, so an interrupted
+// write leaves the previous checkpoint intact. Throws std::runtime_error on
+// I/O errors.
+void WriteCheckpointFile(const std::string &filePath,
+                         const Checkpoint &checkpoint);
+
+// Throws std::runtime_error if the file is not a checkpoint of this version
+Checkpoint ReadCheckpointFile(const std::string &filePath);
+
+} // namespace ArbSim
+
+#endif // CHECKPOINT_H
@@ -8,12 +8,19 @@ namespace ArbSim {
 
 // Buffer sizes
 constexpr size_t kTradeLogBufferSize = 1 << 20;  // 1MB
+constexpr size_t kOutputBufferSize = 1 << 16;    // 64KB, bytes per stdout write
+constexpr size_t kEventBatchSize = 4096;          // merged events per main-loop block
+constexpr long long kCheckpointEveryEvents = 10'000'000;  // default Checkpoint.EveryEvents
+
+// Tie-break seed for merging FutureA and FutureB (part of the timeline cache key)
+constexpr unsigned int kMergeSeed = 42;
 
 // Time constants (nanoseconds)
 constexpr int64_t kNanosecondsPerSecond = 1'000'000'000LL;
 constexpr int64_t kPnlPrintIntervalNs = 60 * kNanosecondsPerSecond;  // 60 seconds
 
 // Precision constants
+constexpr int kPnlDecimals = 6;
 constexpr int64_t kPnlMultiplier = 1'000'000;  // 6 decimal places
 constexpr double kFloatCompareEpsilon = 1e-9;
 
@@ -1,153 +1,452 @@
 #include "CsvReader.h"
+#include "CsvScanner.h"
+#include "PriceParser.h"
+#include "TimeIndex.h"
 
-#include <cstdlib> // Required for std::strtoll, std::strtod
+#include <algorithm>
+#include <chrono>
 #include <cstring> // Required for std::strncmp
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
 
 namespace ArbSim {
 
-CsvReader::CsvReader(const std::string &filePath)
-    : filePath_(filePath), file_(filePath) {
+namespace {
+
+// Initial scan block; large enough to amortize the dispatch, small enough to
+// stay cache-resident until the parser consumes it.
+constexpr size_t kScanBlockBytes = 64 * 1024;
+
+// Events parsed per batch in Compressed mode
+constexpr size_t kParseBatchEvents = 4096;
+
+} // namespace
+
+CsvReader::CsvReader(const std::string &filePath, CsvReaderMode mode)
+    : filePath_(filePath), mode_(mode), cursor_(nullptr), mapEnd_(nullptr),
+      inputExhausted_(false), batchPos_(0), batchCount_(0), parseNs_(0),
+      structuralCount_(0), structuralPos_(0), blockBase_(nullptr),
+      blockEnd_(nullptr), blockBytes_(kScanBlockBytes) {
+  if (mode_ == CsvReaderMode::MemoryMapped) {
+    try {
+      mapped_ = std::make_unique<MappedFile>(filePath_);
+    } catch (const std::runtime_error &) {
+      throw std::runtime_error("CsvReader: Failed to open file: " + filePath_);
+    }
+    mapped_->AdviseSequential();
+    cursor_ = mapped_->Data();
+    mapEnd_ = cursor_ + mapped_->Size();
+    return;
+  }
+
+  if (mode_ == CsvReaderMode::Compressed) {
+    decompressor_ = std::make_unique<DecompressingStream>(
+        filePath_, DetectCompression(filePath_));
+    batch_.resize(kParseBatchEvents);
+    return;
+  }
+
+  file_.open(filePath_);
   if (!file_.is_open()) {
     throw std::runtime_error("CsvReader: Failed to open file: " + filePath_);
   }
   // Reserve memory for typical line length to prevent early reallocations
   lineBuffer_.reserve(128);
+  structural_.resize(128);
 }
 
-bool CsvReader::IsOpen() const { return file_.is_open(); }
+CsvReader::CsvReader(const std::string &name, const char *data, size_t size)
+    : filePath_(name), mode_(CsvReaderMode::MemoryMapped), cursor_(data),
+      mapEnd_(data + size), inputExhausted_(false), batchPos_(0),
+      batchCount_(0), parseNs_(0), structuralCount_(0), structuralPos_(0),
+      blockBase_(nullptr), blockEnd_(nullptr), blockBytes_(kScanBlockBytes) {}
+
+bool CsvReader::IsOpen() const {
+  switch (mode_) {
+  case CsvReaderMode::MemoryMapped:
+    return mapped_ != nullptr || mapEnd_ != nullptr;
+  case CsvReaderMode::Compressed:
+    return decompressor_ != nullptr;
+  default:
+    return file_.is_open();
+  }
+}
 
 const std::string &CsvReader::GetFilePath() const { return filePath_; }
 
-bool CsvReader::ReadNextNonEmptyLine() {
+CsvReaderMode CsvReader::GetMode() const { return mode_; }
+
+bool CsvReader::NextLine(LineFields &line) {
+  const bool ok = (mode_ == CsvReaderMode::Stream) ? NextStreamLine(line)
+                                                  : NextMappedLine(line);
+  if (!ok) {
+    return false;
+  }
+
+  // Strip CR if present (CRLF files)
+  if (line.end > line.begin && line.end[-1] == '\r') {
+    --line.end;
+  }
+  return true;
+}
+
+bool CsvReader::NextStreamLine(LineFields &line) {
   while (std::getline(file_, lineBuffer_)) {
-    if (!lineBuffer_.empty()) {
+    if (lineBuffer_.empty()) {
+      continue;
+    }
+
+    if (structural_.size() < lineBuffer_.size()) {
+      structural_.resize(lineBuffer_.size());
+    }
+
+    const char *begin = lineBuffer_.data();
+    const char *end = begin + lineBuffer_.size();
+    const size_t count = ScanStructural(begin, end, structural_.data());
+
+    line.begin = begin;
+    line.end = end;
+    line.commaCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (line.commaCount < 6) {
+        line.commas[line.commaCount] = begin + structural_[i];
+      }
+      ++line.commaCount;
+    }
+    return true;
+  }
+  return false;
+}
+
+void CsvReader::ScanNextBlock() {
+  // A line longer than the whole block: grow so the rescan makes progress
+  if (cursor_ == blockBase_ && blockEnd_ != nullptr) {
+    blockBytes_ *= 2;
+  }
+
+  const size_t remaining = static_cast<size_t>(mapEnd_ - cursor_);
+  const size_t bytes = remaining < blockBytes_ ? remaining : blockBytes_;
+  if (structural_.size() < bytes) {
+    structural_.resize(bytes);
+  }
+
+  blockBase_ = cursor_;
+  blockEnd_ = cursor_ + bytes;
+  structuralCount_ = ScanStructural(blockBase_, blockEnd_, structural_.data());
+  structuralPos_ = 0;
+}
+
+bool CsvReader::RefillWindow(const char *carryBegin) {
+  if (decompressor_ == nullptr || inputExhausted_) {
+    return false;
+  }
+
+  // The chunk holding the carry is released by NextChunk(), so save it first
+  carry_.assign(carryBegin, mapEnd_);
+
+  char *data = nullptr;
+  size_t size = 0;
+  if (!decompressor_->NextChunk(data, size)) {
+    // No more input: whatever was carried is the last line
+    inputExhausted_ = true;
+    cursor_ = carry_.data();
+    mapEnd_ = cursor_ + carry_.size();
+  } else {
+    if (carry_.size() > DecompressingStream::kHeadroom) {
+      throw std::runtime_error("CsvReader: line longer than " +
+                               std::to_string(DecompressingStream::kHeadroom) +
+                               " bytes in: " + filePath_);
+    }
+    char *start = data - carry_.size();
+    std::memcpy(start, carry_.data(), carry_.size());
+    cursor_ = start;
+    mapEnd_ = data + size;
+  }
+
+  blockBase_ = nullptr;
+  blockEnd_ = nullptr;
+  structuralCount_ = 0;
+  structuralPos_ = 0;
+  return cursor_ < mapEnd_;
+}
+
+bool CsvReader::NextMappedLine(LineFields &line) {
+  while (cursor_ < mapEnd_ || RefillWindow(cursor_)) {
+    if (structuralPos_ == structuralCount_ || blockBase_ == nullptr) {
+      ScanNextBlock();
+    }
+
+    const char *lineBegin = cursor_;
+    int commas = 0;
+
+    while (structuralPos_ < structuralCount_) {
+      const char *p = blockBase_ + structural_[structuralPos_++];
+      if (*p == ',') {
+        if (commas < 6) {
+          line.commas[commas] = p;
+        }
+        ++commas;
+        continue;
+      }
+
+      // '\n'
+      cursor_ = p + 1;
+      if (p == lineBegin) {
+        lineBegin = cursor_; // skip empty line
+        continue;
+      }
+
+      line.begin = lineBegin;
+      line.end = p;
+      line.commaCount = commas;
       return true;
     }
+
+    if (blockEnd_ == mapEnd_) {
+      // Compressed: the line continues in the next chunk
+      if (RefillWindow(lineBegin)) {
+        continue;
+      }
+
+      // Last line without a trailing newline
+      cursor_ = mapEnd_;
+      if (lineBegin == mapEnd_) {
+        return false;
+      }
+      line.begin = lineBegin;
+      line.end = mapEnd_;
+      line.commaCount = commas;
+      return true;
+    }
+
+    // Line straddles the block end: rescan starting at its first byte
+    cursor_ = lineBegin;
+    structuralPos_ = structuralCount_;
   }
   return false;
 }
 
-void CsvReader::StripTrailingCarriageReturn(std::string &line) {
-  if (!line.empty() && line.back() == '\r') {
-    line.pop_back();
+bool CsvReader::SeekToTime(long long time) {
+  // Compressed input and in-memory buffers have no file to index
+  if (mode_ == CsvReaderMode::Compressed ||
+      (mode_ == CsvReaderMode::MemoryMapped && mapped_ == nullptr)) {
+    return false;
+  }
+
+  const uint64_t offset = TimeIndex::LoadOrBuild(filePath_).FindOffset(time);
+  if (mode_ == CsvReaderMode::MemoryMapped) {
+    cursor_ = mapped_->Data() + offset;
+    blockBase_ = nullptr;
+    blockEnd_ = nullptr;
+    structuralCount_ = 0;
+    structuralPos_ = 0;
+    return true;
+  }
+
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(offset));
+  return static_cast<bool>(file_);
+}
+
+bool CsvReader::FillBatch() {
+  if (batchError_) {
+    std::rethrow_exception(batchError_);
+  }
+
+  const double waitBeforeMs = decompressor_->GetWaitMs();
+  const auto t0 = std::chrono::steady_clock::now();
+
+  batchPos_ = 0;
+  batchCount_ = 0;
+  try {
+    LineFields line;
+    while (batchCount_ < batch_.size() && NextLine(line)) {
+      ParseLine(line, batch_[batchCount_]);
+      ++batchCount_;
+    }
+  } catch (...) {
+    // Rethrown once the events parsed before it have been delivered
+    batchError_ = std::current_exception();
+  }
+
+  // Time blocked on the decompressor is not parse time
+  const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - t0)
+                             .count();
+  const double waitNs = (decompressor_->GetWaitMs() - waitBeforeMs) * 1e6;
+  if (elapsedNs > waitNs) {
+    parseNs_ += static_cast<uint64_t>(elapsedNs - waitNs);
+  }
+
+  if (batchCount_ == 0 && batchError_) {
+    std::rethrow_exception(batchError_);
+  }
+  return batchCount_ > 0;
+}
+
+size_t CsvReader::ReadEvents(MarketEvent *out, size_t max) {
+  if (mode_ == CsvReaderMode::Compressed) {
+    size_t n = 0;
+    while (n < max) {
+      if (batchPos_ == batchCount_ && !FillBatch()) {
+        break;
+      }
+      const size_t take = std::min(max - n, batchCount_ - batchPos_);
+      std::copy_n(batch_.data() + batchPos_, take, out + n);
+      batchPos_ += take;
+      n += take;
+    }
+    return n;
+  }
+
+  if (batchError_) {
+    std::rethrow_exception(batchError_);
+  }
+
+  size_t n = 0;
+  try {
+    LineFields line;
+    while (n < max && NextLine(line)) {
+      ParseLine(line, out[n]);
+      ++n;
+    }
+  } catch (...) {
+    // Deliver the events before the bad line; throw on the next call
+    if (n == 0) {
+      throw;
+    }
+    batchError_ = std::current_exception();
   }
+  return n;
 }
 
 bool CsvReader::ReadNextEvent(MarketEvent &event) {
-  if (!ReadNextNonEmptyLine()) {
+  if (mode_ == CsvReaderMode::Compressed) {
+    if (batchPos_ == batchCount_ && !FillBatch()) {
+      return false;
+    }
+    event = batch_[batchPos_++];
+    return true;
+  }
+
+  if (batchError_) {
+    std::rethrow_exception(batchError_);
+  }
+
+  LineFields line;
+  if (!NextLine(line)) {
     return false;
   }
 
-  StripTrailingCarriageReturn(lineBuffer_);
+  ParseLine(line, event);
+  return true;
+}
 
-  // Validate field count (expect exactly 7 fields: 6 commas)
-  int commaCount = 0;
-  for (char c : lineBuffer_) {
-    if (c == ',') ++commaCount;
+void CsvReader::PrintStats(std::ostream &out) const {
+  if (decompressor_ == nullptr) {
+    return;
   }
-  if (commaCount != 6) {
+  out << "Decompress " << filePath_ << ": "
+      << decompressor_->GetCompressedBytes() / (1024.0 * 1024.0) << " MB -> "
+      << decompressor_->GetDecompressedBytes() / (1024.0 * 1024.0)
+      << " MB, decompress " << decompressor_->GetDecompressMs()
+      << " ms (helper thread), parse " << parseNs_ / 1e6
+      << " ms, waited for data " << decompressor_->GetWaitMs() << " ms\n";
+}
+
+void CsvReader::ParseLine(const LineFields &fields, MarketEvent &event) {
+  const char *const begin = fields.begin;
+  const char *const end = fields.end;
+
+  // Validate field count (expect exactly 7 fields: 6 commas)
+  if (fields.commaCount != 6) {
+    const size_t len = static_cast<size_t>(end - begin);
     throw std::runtime_error("CSV format error: expected 7 fields (6 commas), got " +
-                             std::to_string(commaCount + 1) + " fields in: " +
-                             lineBuffer_.substr(0, 50) + (lineBuffer_.size() > 50 ? "..." : ""));
+                             std::to_string(fields.commaCount + 1) + " fields in: " +
+                             std::string(begin, len > 50 ? 50 : len) +
+                             (len > 50 ? "..." : ""));
   }
 
-  const char *ptr = lineBuffer_.data();
-  const char *const end = ptr + lineBuffer_.size();
+  // Field k spans [fieldBegin(k), fieldEnd(k)); the separators were already
+  // located by the structural scan, so each byte is parsed exactly once.
+  auto fieldBegin = [&](int k) { return k == 0 ? begin : fields.commas[k - 1] + 1; };
+  auto fieldEnd = [&](int k) { return k == 6 ? end : fields.commas[k]; };
 
-  auto skipComma = [&]() {
-    if (ptr < end && *ptr == ',') {
+  auto line = [&]() { return std::string(begin, end); };
+
+  auto skipBlanks = [](const char *ptr, const char *last) {
+    while (ptr < last && (*ptr == ' ' || *ptr == '\t')) {
       ++ptr;
-      return true;
     }
-    return false;
+    return ptr;
   };
 
-  // r integer parsing 
-  auto parseInt = [&](auto &out) -> bool {
-    char *endPtr = nullptr;
-    long long val = std::strtoll(ptr, &endPtr, 10);
-
-    if (ptr == endPtr) {
-      return false; // No digits found
+  // integer parsing (bounded by the field: mapped lines are not NUL-terminated)
+  auto parseInt = [&](int k, auto &out) -> bool {
+    const char *last = fieldEnd(k);
+    long long val = 0;
+    const auto res = std::from_chars(skipBlanks(fieldBegin(k), last), last, val);
+    if (res.ec != std::errc()) {
+      return false; // No digits found (or out of range)
     }
 
     out = static_cast<std::decay_t<decltype(out)>>(val);
-    ptr = endPtr;
     return true;
   };
 
-  // double parsing 
-  auto parseDouble = [&](double &out) -> bool {
-    char *endPtr = nullptr;
-    out = std::strtod(ptr, &endPtr);
-
-    if (ptr == endPtr) {
-      return false; // No digits found
-    }
-
-    ptr = endPtr;
-    return true;
+  // price parsing to ticks (locale-free, equal to PriceToTicks of the
+  // strtod value)
+  auto parseTicks = [&](int k, int64_t &out) -> bool {
+    const char *last = fieldEnd(k);
+    return ParsePriceTicks(skipBlanks(fieldBegin(k), last), last, out) !=
+           nullptr;
   };
 
   // parse timestamp
-  if (!parseInt(event.sendingTime)) {
-    throw std::runtime_error("Parse error: sendingTime in " + lineBuffer_);
-  }
-  skipComma();
-
-  // parse instrumentId 
-  const char *tokenEnd = ptr;
-  while (tokenEnd < end && *tokenEnd != ',') {
-    ++tokenEnd;
+  if (!parseInt(0, event.sendingTime)) {
+    throw std::runtime_error("Parse error: sendingTime in " + line());
   }
 
-  // Calculate length 
-  std::ptrdiff_t len = tokenEnd - ptr;
+  // parse instrumentId
+  const char *token = fieldBegin(1);
+  const std::ptrdiff_t len = fieldEnd(1) - token;
 
   // "FutureA" (length 7)
-  if (len == 7 && std::strncmp(ptr, "FutureA", 7) == 0) {
+  if (len == 7 && std::strncmp(token, "FutureA", 7) == 0) {
     event.instrumentId = InstrumentId::FutureA;
   }
   // "FutureB" (length 7)
-  else if (len == 7 && std::strncmp(ptr, "FutureB", 7) == 0) {
+  else if (len == 7 && std::strncmp(token, "FutureB", 7) == 0) {
     event.instrumentId = InstrumentId::FutureB;
   } else {
     event.instrumentId = InstrumentId::Unknown;
   }
 
-  ptr = tokenEnd;
-  skipComma();
-
-  // eventTypeId 
-  if (!parseInt(event.eventTypeId)) {
-    throw std::runtime_error("Parse error: eventTypeId in " + lineBuffer_);
+  // eventTypeId
+  if (!parseInt(2, event.eventTypeId)) {
+    throw std::runtime_error("Parse error: eventTypeId in " + line());
   }
-  skipComma();
 
   // bidSize
-  if (!parseInt(event.bidSize)) {
-    throw std::runtime_error("Parse error: bidSize in " + lineBuffer_);
+  if (!parseInt(3, event.bidSize)) {
+    throw std::runtime_error("Parse error: bidSize in " + line());
   }
-  skipComma();
 
-  // bid 
-  if (!parseDouble(event.bid)) {
-    throw std::runtime_error("Parse error: bid in " + lineBuffer_);
+  // bid
+  if (!parseTicks(4, event.bidTicks)) {
+    throw std::runtime_error("Parse error: bid in " + line());
   }
-  skipComma();
 
-  // ask 
-  if (!parseDouble(event.ask)) {
-    throw std::runtime_error("Parse error: ask in " + lineBuffer_);
+  // ask
+  if (!parseTicks(5, event.askTicks)) {
+    throw std::runtime_error("Parse error: ask in " + line());
   }
-  skipComma();
 
   // askSize
-  if (!parseInt(event.askSize)) {
-    throw std::runtime_error("Parse error: askSize in " + lineBuffer_);
+  if (!parseInt(6, event.askSize)) {
+    throw std::runtime_error("Parse error: askSize in " + line());
   }
-
-  return true;
 }
 
-} // namespace ArbSim
\ No newline at end of file
+} // namespace ArbSim
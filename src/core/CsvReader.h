@@ -1,37 +1,110 @@
 #ifndef CSV_READER_H
 #define CSV_READER_H
 
+#include "DecompressingStream.h"
+#include "IEventSource.h"
+#include "MappedFile.h"
 #include "MarketData.h"
 #include <charconv> // Required for std::from_chars
+#include <cstdint>
+#include <exception>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
 
 namespace ArbSim {
 
-class CsvReader {
+// How the reader pulls bytes from disk
+enum class CsvReaderMode {
+  Stream,       // std::ifstream + std::getline into a reused line buffer
+  MemoryMapped, // parse straight out of the mapped pages (zero-copy)
+  Compressed,   // .gz / .zst decompressed on a helper thread, parsed in place
+};
+
+class CsvReader : public IEventSource {
 public:
-  explicit CsvReader(const std::string &filePath);
+  explicit CsvReader(const std::string &filePath,
+                     CsvReaderMode mode = CsvReaderMode::MemoryMapped);
+
+  // Parses CSV bytes already in memory (MemoryMapped mode over a buffer the
+  // caller keeps alive); name is reported by GetFilePath().
+  CsvReader(const std::string &name, const char *data, size_t size);
 
   bool IsOpen() const;
-  const std::string &GetFilePath() const;
+  const std::string &GetFilePath() const override;
+  CsvReaderMode GetMode() const;
 
-  bool ReadNextEvent(MarketEvent &event);
+  bool ReadNextEvent(MarketEvent &event) override;
+  size_t ReadEvents(MarketEvent *out, size_t max) override;
+  // Seeks through the sparse sidecar index (built on first use);
+  // not supported in Compressed mode
+  bool SeekToTime(long long time) override;
+  // Compressed mode: decompress vs parse time
+  void PrintStats(std::ostream &out) const override;
 
 private:
   std::string filePath_;
+  CsvReaderMode mode_;
+
+  // Stream mode
   std::ifstream file_;
 
   // Reused buffer to minimize heap allocations
   std::string lineBuffer_;
 
-  bool ReadNextNonEmptyLine();
+  // MemoryMapped mode
+  std::unique_ptr<MappedFile> mapped_;
+  const char *cursor_;
+  const char *mapEnd_;
+
+  // Compressed mode: the window [cursor_, mapEnd_) is the current
+  // decompressed chunk; a line cut by the chunk end is carried into the
+  // next chunk's headroom.
+  std::unique_ptr<DecompressingStream> decompressor_;
+  std::string carry_;
+  bool inputExhausted_;
+
+  // Compressed mode parses ahead in batches so parse time can be measured
+  // without a clock read per event
+  std::vector<MarketEvent> batch_;
+  size_t batchPos_;
+  size_t batchCount_;
+  // Parse error held back until the events before it have been delivered
+  std::exception_ptr batchError_;
+  uint64_t parseNs_;
+
+  // Structural index (',' and '\n' offsets) of the current block, produced
+  // by one vectorized pass; lines and fields are cut from it without
+  // re-walking the bytes.
+  std::vector<uint32_t> structural_;
+  size_t structuralCount_;
+  size_t structuralPos_;
+  const char *blockBase_;
+  const char *blockEnd_;
+  size_t blockBytes_;
+
+  // One line with its field separators located
+  struct LineFields {
+    const char *begin;
+    const char *end; // CR already stripped
+    const char *commas[6];
+    int commaCount;
+  };
+
+  // Yields the next non-empty line
+  bool NextLine(LineFields &line);
+  bool NextStreamLine(LineFields &line);
+  bool NextMappedLine(LineFields &line);
+  void ScanNextBlock();
+  bool RefillWindow(const char *carryBegin);
+  bool FillBatch();
 
-  // Helper to strip CR if present
-  static void StripTrailingCarriageReturn(std::string &line);
+  // Parses one 7-field line; throws std::runtime_error on malformed input
+  static void ParseLine(const LineFields &line, MarketEvent &event);
 };
 
 } // namespace ArbSim
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,167 @@
+#include "CsvScanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define ARBSIM_SCANNER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define ARBSIM_TARGET_AVX2
+#else
+#define ARBSIM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace ArbSim {
+
+namespace {
+
+inline unsigned CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx = 0;
+  _BitScanForward(&idx, mask);
+  return static_cast<unsigned>(idx);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Appends base + index of every set bit in mask
+inline size_t EmitMask(uint32_t mask, uint32_t base, uint32_t *out,
+                       size_t n) {
+  while (mask != 0) {
+    out[n++] = base + CountTrailingZeros(mask);
+    mask &= mask - 1;
+  }
+  return n;
+}
+
+size_t ScanScalarFrom(const char *begin, const char *p, const char *end,
+                      uint32_t *out, size_t n) {
+  for (; p < end; ++p) {
+    if (*p == ',' || *p == '\n') {
+      out[n++] = static_cast<uint32_t>(p - begin);
+    }
+  }
+  return n;
+}
+
+size_t ScanScalar(const char *begin, const char *end, uint32_t *out) {
+  return ScanScalarFrom(begin, begin, end, out, 0);
+}
+
+#ifdef ARBSIM_SCANNER_X86
+
+size_t ScanSse2(const char *begin, const char *end, uint32_t *out) {
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  size_t n = 0;
+  const char *p = begin;
+  for (; end - p >= 16; p += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, comma),
+                                      _mm_cmpeq_epi8(chunk, newline));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+    n = EmitMask(mask, static_cast<uint32_t>(p - begin), out, n);
+  }
+  return ScanScalarFrom(begin, p, end, out, n);
+}
+
+ARBSIM_TARGET_AVX2
+size_t ScanAvx2(const char *begin, const char *end, uint32_t *out) {
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i newline = _mm256_set1_epi8('\n');
+
+  size_t n = 0;
+  const char *p = begin;
+  for (; end - p >= 32; p += 32) {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma),
+                                         _mm256_cmpeq_epi8(chunk, newline));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+    n = EmitMask(mask, static_cast<uint32_t>(p - begin), out, n);
+  }
+  return ScanScalarFrom(begin, p, end, out, n);
+}
+
+bool CpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4] = {};
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // ARBSIM_SCANNER_X86
+
+using ScanFn = size_t (*)(const char *, const char *, uint32_t *);
+
+ScanFn Resolve(ScannerKind kind) {
+#ifdef ARBSIM_SCANNER_X86
+  switch (kind) {
+  case ScannerKind::Avx2:
+    return CpuHasAvx2() ? &ScanAvx2 : &ScanSse2;
+  case ScannerKind::Sse2:
+    return &ScanSse2;
+  case ScannerKind::Scalar:
+  default:
+    return &ScanScalar;
+  }
+#else
+  (void)kind;
+  return &ScanScalar;
+#endif
+}
+
+} // namespace
+
+ScannerKind DetectScannerKind() {
+#ifdef ARBSIM_SCANNER_X86
+  return CpuHasAvx2() ? ScannerKind::Avx2 : ScannerKind::Sse2;
+#else
+  return ScannerKind::Scalar;
+#endif
+}
+
+const char *ScannerKindName(ScannerKind kind) {
+  switch (kind) {
+  case ScannerKind::Avx2:
+    return "avx2";
+  case ScannerKind::Sse2:
+    return "sse2";
+  case ScannerKind::Scalar:
+  default:
+    return "scalar";
+  }
+}
+
+size_t ScanStructural(const char *begin, const char *end, uint32_t *out) {
+  // Resolved once, on first use
+  static const ScanFn fn = Resolve(DetectScannerKind());
+  return fn(begin, end, out);
+}
+
+size_t ScanStructural(ScannerKind kind, const char *begin, const char *end,
+                      uint32_t *out) {
+  return Resolve(kind)(begin, end, out);
+}
+
+} // namespace ArbSim
@@ -0,0 +1,29 @@
+#ifndef CSV_SCANNER_H
+#define CSV_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ArbSim {
+
+// Structural scan of a block of CSV text: finds every ',' and '\n' in one
+// pass over [begin, end) and writes their offsets (relative to begin), in
+// ascending order, to out. out must have room for (end - begin) entries.
+// Returns the number of offsets written.
+//
+// The implementation is picked once at runtime: AVX2 (32 bytes/step),
+// SSE2 (16 bytes/step) or a portable scalar loop.
+size_t ScanStructural(const char *begin, const char *end, uint32_t *out);
+
+// Forces a specific implementation (tests/benchmarks).
+enum class ScannerKind { Scalar, Sse2, Avx2 };
+size_t ScanStructural(ScannerKind kind, const char *begin, const char *end,
+                      uint32_t *out);
+
+// Best implementation supported by this CPU
+ScannerKind DetectScannerKind();
+const char *ScannerKindName(ScannerKind kind);
+
+} // namespace ArbSim
+
+#endif // CSV_SCANNER_H
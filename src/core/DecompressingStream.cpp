@@ -0,0 +1,375 @@
+#include "DecompressingStream.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef ARBSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef ARBSIM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace ArbSim {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t ElapsedNs(Clock::time_point since) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           since)
+          .count());
+}
+
+const unsigned char kGzipMagic[] = {0x1f, 0x8b};
+const unsigned char kZstdMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+} // namespace
+
+Compression DetectCompression(const std::string &filePath) {
+  std::FILE *f = std::fopen(filePath.c_str(), "rb");
+  if (f == nullptr) {
+    return Compression::None;
+  }
+  unsigned char magic[4] = {};
+  const size_t n = std::fread(magic, 1, sizeof(magic), f);
+  std::fclose(f);
+
+  if (n >= sizeof(kGzipMagic) &&
+      std::memcmp(magic, kGzipMagic, sizeof(kGzipMagic)) == 0) {
+    return Compression::Gzip;
+  }
+  if (n >= sizeof(kZstdMagic) &&
+      std::memcmp(magic, kZstdMagic, sizeof(kZstdMagic)) == 0) {
+    return Compression::Zstd;
+  }
+  return Compression::None;
+}
+
+DecompressingStream::DecompressingStream(const std::string &filePath,
+                                         Compression compression)
+    : filePath_(filePath), compression_(compression), file_(nullptr),
+      ring_(kRingChunks), holdingChunk_(false), producerDone_(false),
+      stop_(false), decompressNs_(0), compressedBytes_(0),
+      decompressedBytes_(0), waitNs_(0) {
+  file_ = std::fopen(filePath_.c_str(), "rb");
+  if (file_ == nullptr) {
+    throw std::runtime_error("DecompressingStream: Failed to open file: " +
+                             filePath_);
+  }
+
+  const char *unsupported = nullptr;
+  switch (compression_) {
+  case Compression::None:
+    unsupported = "not a gzip or zstd file";
+    break;
+  case Compression::Gzip:
+#ifndef ARBSIM_HAVE_ZLIB
+    unsupported = "built without zlib, cannot read gzip";
+#endif
+    break;
+  case Compression::Zstd:
+#ifndef ARBSIM_HAVE_ZSTD
+    unsupported = "built without zstd, cannot read zstd";
+#endif
+    break;
+  }
+  if (unsupported != nullptr) {
+    std::fclose(file_);
+    throw std::runtime_error(std::string("DecompressingStream: ") +
+                             unsupported + ": " + filePath_);
+  }
+
+  producer_ = std::thread(&DecompressingStream::ProducerLoop, this);
+}
+
+DecompressingStream::~DecompressingStream() {
+  stop_.store(true, std::memory_order_relaxed);
+  if (producer_.joinable()) {
+    producer_.join();
+  }
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+}
+
+// --- Producer ---
+
+DecompressingStream::Chunk *DecompressingStream::AcquireChunk() {
+  Chunk *chunk = ring_.BeginPush();
+  while (chunk == nullptr) {
+    if (stop_.load(std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    std::this_thread::yield();
+    chunk = ring_.BeginPush();
+  }
+  if (chunk->buffer.size() != kHeadroom + kChunkBytes) {
+    chunk->buffer.resize(kHeadroom + kChunkBytes);
+  }
+  chunk->size = 0;
+  return chunk;
+}
+
+void DecompressingStream::PublishChunk(Chunk *chunk) {
+  decompressedBytes_.fetch_add(chunk->size, std::memory_order_relaxed);
+  ring_.CommitPush();
+}
+
+void DecompressingStream::ProducerLoop() {
+  try {
+    if (compression_ == Compression::Gzip) {
+      RunGzip();
+    } else {
+      RunZstd();
+    }
+  } catch (...) {
+    // Published before producerDone_ (release), read after it (acquire)
+    error_ = std::current_exception();
+  }
+  producerDone_.store(true, std::memory_order_release);
+}
+
+void DecompressingStream::RunGzip() {
+#ifdef ARBSIM_HAVE_ZLIB
+  struct Inflater {
+    z_stream zs{};
+    Inflater() {
+      // 15 + 32: max window, auto-detect gzip/zlib header
+      if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+        throw std::runtime_error("DecompressingStream: inflateInit2 failed");
+      }
+    }
+    ~Inflater() { inflateEnd(&zs); }
+  } inflater;
+  z_stream &zs = inflater.zs;
+
+  std::vector<unsigned char> input(kInputBytes);
+  bool eof = false;
+  bool inMember = false;
+
+  Chunk *out = AcquireChunk();
+  if (out == nullptr) {
+    return;
+  }
+  auto resetOutput = [&]() {
+    zs.next_out = reinterpret_cast<Bytef *>(out->buffer.data() + kHeadroom);
+    zs.avail_out = static_cast<uInt>(kChunkBytes);
+  };
+  resetOutput();
+
+  auto t0 = Clock::now();
+  // Output decompressed before a failure is still delivered
+  std::exception_ptr failure;
+  try {
+    for (;;) {
+      if (zs.avail_in == 0 && !eof) {
+        const size_t n = std::fread(input.data(), 1, input.size(), file_);
+        if (n == 0) {
+          if (std::ferror(file_)) {
+            throw std::runtime_error("DecompressingStream: read error in: " +
+                                     filePath_);
+          }
+          eof = true;
+        }
+        compressedBytes_.fetch_add(n, std::memory_order_relaxed);
+        zs.next_in = input.data();
+        zs.avail_in = static_cast<uInt>(n);
+      }
+      if (zs.avail_in == 0 && eof) {
+        break;
+      }
+
+      inMember = true;
+      const int ret = inflate(&zs, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END) {
+        // Concatenated gzip members are valid; start the next one
+        inMember = false;
+        inflateReset(&zs);
+      } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        throw std::runtime_error(
+            std::string("DecompressingStream: gzip error (") +
+            (zs.msg ? zs.msg : "corrupt data") + ") in: " + filePath_);
+      }
+
+      if (zs.avail_out == 0) {
+        out->size = kChunkBytes;
+        decompressNs_.fetch_add(ElapsedNs(t0), std::memory_order_relaxed);
+        PublishChunk(out);
+        out = AcquireChunk();
+        if (out == nullptr) {
+          return;
+        }
+        t0 = Clock::now();
+        resetOutput();
+      }
+    }
+
+    if (inMember) {
+      throw std::runtime_error(
+          "DecompressingStream: truncated gzip stream in: " + filePath_);
+    }
+  } catch (...) {
+    failure = std::current_exception();
+  }
+
+  out->size = kChunkBytes - zs.avail_out;
+  decompressNs_.fetch_add(ElapsedNs(t0), std::memory_order_relaxed);
+  if (out->size > 0) {
+    PublishChunk(out);
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+#endif
+}
+
+void DecompressingStream::RunZstd() {
+#ifdef ARBSIM_HAVE_ZSTD
+  struct Decoder {
+    ZSTD_DStream *ds = ZSTD_createDStream();
+    Decoder() {
+      if (ds == nullptr || ZSTD_isError(ZSTD_initDStream(ds))) {
+        throw std::runtime_error("DecompressingStream: ZSTD_initDStream failed");
+      }
+    }
+    ~Decoder() { ZSTD_freeDStream(ds); }
+  } decoder;
+
+  std::vector<char> input(kInputBytes);
+  ZSTD_inBuffer in{input.data(), 0, 0};
+
+  Chunk *out = AcquireChunk();
+  if (out == nullptr) {
+    return;
+  }
+  ZSTD_outBuffer outBuf{out->buffer.data() + kHeadroom, kChunkBytes, 0};
+
+  size_t lastRet = 0;
+  bool eof = false;
+  auto t0 = Clock::now();
+  // Output decompressed before a failure is still delivered
+  std::exception_ptr failure;
+  try {
+    for (;;) {
+      if (in.pos == in.size && !eof) {
+        const size_t n = std::fread(input.data(), 1, input.size(), file_);
+        if (n == 0) {
+          if (std::ferror(file_)) {
+            throw std::runtime_error("DecompressingStream: read error in: " +
+                                     filePath_);
+          }
+          eof = true;
+        }
+        compressedBytes_.fetch_add(n, std::memory_order_relaxed);
+        in.size = n;
+        in.pos = 0;
+      }
+      // Last frame complete and flushed (another call would open a new one)
+      if (eof && in.pos == in.size && lastRet == 0) {
+        break;
+      }
+
+      const size_t before = outBuf.pos;
+      lastRet = ZSTD_decompressStream(decoder.ds, &outBuf, &in);
+      if (ZSTD_isError(lastRet)) {
+        throw std::runtime_error(
+            std::string("DecompressingStream: zstd error (") +
+            ZSTD_getErrorName(lastRet) + ") in: " + filePath_);
+      }
+
+      if (outBuf.pos == outBuf.size) {
+        out->size = outBuf.pos;
+        decompressNs_.fetch_add(ElapsedNs(t0), std::memory_order_relaxed);
+        PublishChunk(out);
+        out = AcquireChunk();
+        if (out == nullptr) {
+          return;
+        }
+        t0 = Clock::now();
+        outBuf = ZSTD_outBuffer{out->buffer.data() + kHeadroom, kChunkBytes, 0};
+        continue;
+      }
+
+      // Input exhausted and the decoder has nothing left to flush
+      if (eof && in.pos == in.size && outBuf.pos == before) {
+        break;
+      }
+    }
+
+    if (lastRet != 0) {
+      throw std::runtime_error(
+          "DecompressingStream: truncated zstd frame in: " + filePath_);
+    }
+  } catch (...) {
+    failure = std::current_exception();
+  }
+
+  out->size = outBuf.pos;
+  decompressNs_.fetch_add(ElapsedNs(t0), std::memory_order_relaxed);
+  if (out->size > 0) {
+    PublishChunk(out);
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+#endif
+}
+
+// --- Consumer ---
+
+bool DecompressingStream::NextChunk(char *&data, size_t &size) {
+  if (holdingChunk_) {
+    ring_.Pop();
+    holdingChunk_ = false;
+  }
+
+  Chunk *chunk = ring_.Front();
+  if (chunk == nullptr) {
+    const auto t0 = Clock::now();
+    while ((chunk = ring_.Front()) == nullptr) {
+      if (producerDone_.load(std::memory_order_acquire)) {
+        // The last chunk may have been published just before finishing
+        chunk = ring_.Front();
+        break;
+      }
+      std::this_thread::yield();
+    }
+    waitNs_ += ElapsedNs(t0);
+  }
+
+  if (chunk == nullptr) {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return false;
+  }
+
+  holdingChunk_ = true;
+  data = chunk->buffer.data() + kHeadroom;
+  size = chunk->size;
+  return true;
+}
+
+double DecompressingStream::GetDecompressMs() const {
+  return static_cast<double>(decompressNs_.load(std::memory_order_relaxed)) /
+         1e6;
+}
+
+double DecompressingStream::GetWaitMs() const {
+  return static_cast<double>(waitNs_) / 1e6;
+}
+
+uint64_t DecompressingStream::GetCompressedBytes() const {
+  return compressedBytes_.load(std::memory_order_relaxed);
+}
+
+uint64_t DecompressingStream::GetDecompressedBytes() const {
+  return decompressedBytes_.load(std::memory_order_relaxed);
+}
+
+} // namespace ArbSim
@@ -0,0 +1,89 @@
+#ifndef DECOMPRESSING_STREAM_H
+#define DECOMPRESSING_STREAM_H
+
+#include "SpscRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ArbSim {
+
+enum class Compression { None, Gzip, Zstd };
+
+// Detects gzip / zstd from the file's magic bytes
+Compression DetectCompression(const std::string &filePath);
+
+// Decompresses a gzip or zstd file on a helper thread into large chunks
+// handed over through an SPSC ring. Each chunk is preceded by kHeadroom
+// writable bytes so the consumer can prepend the unfinished line carried
+// over from the previous chunk without another copy of the whole chunk.
+//
+// Support is compiled in when zlib (ARBSIM_HAVE_ZLIB) / zstd
+// (ARBSIM_HAVE_ZSTD) are found at configure time; otherwise the constructor
+// throws for that format.
+class DecompressingStream {
+public:
+  static constexpr size_t kHeadroom = 64 * 1024;
+  static constexpr size_t kChunkBytes = 4 * 1024 * 1024;
+  static constexpr size_t kInputBytes = 1024 * 1024;
+  static constexpr size_t kRingChunks = 4;
+
+  DecompressingStream(const std::string &filePath, Compression compression);
+  ~DecompressingStream();
+
+  DecompressingStream(const DecompressingStream &) = delete;
+  DecompressingStream &operator=(const DecompressingStream &) = delete;
+
+  // Releases the previous chunk and returns the next one; data points at
+  // the first decompressed byte with kHeadroom writable bytes before it.
+  // Returns false at end of stream; rethrows decompression errors.
+  bool NextChunk(char *&data, size_t &size);
+
+  // Helper-thread time spent reading + decompressing
+  double GetDecompressMs() const;
+  // Consumer time spent waiting for a chunk
+  double GetWaitMs() const;
+  uint64_t GetCompressedBytes() const;
+  uint64_t GetDecompressedBytes() const;
+
+private:
+  struct Chunk {
+    std::vector<char> buffer; // kHeadroom + kChunkBytes
+    size_t size = 0;
+  };
+
+  std::string filePath_;
+  Compression compression_;
+  std::FILE *file_;
+
+  SpscRing<Chunk> ring_;
+  bool holdingChunk_;
+
+  std::atomic<bool> producerDone_;
+  std::atomic<bool> stop_;
+  std::exception_ptr error_;
+
+  std::atomic<uint64_t> decompressNs_;
+  std::atomic<uint64_t> compressedBytes_;
+  std::atomic<uint64_t> decompressedBytes_;
+  uint64_t waitNs_;
+
+  std::thread producer_;
+
+  void ProducerLoop();
+  void RunGzip();
+  void RunZstd();
+
+  // Producer helpers: current output chunk, published when full
+  Chunk *AcquireChunk();
+  void PublishChunk(Chunk *chunk);
+};
+
+} // namespace ArbSim
+
+#endif // DECOMPRESSING_STREAM_H
@@ -0,0 +1,24 @@
+#include "EventSourceFactory.h"
+
+#include "BinaryEventFile.h"
+#include "CsvReader.h"
+#include "DecompressingStream.h"
+#include "ParallelCsvReader.h"
+
+namespace ArbSim {
+
+std::unique_ptr<IEventSource> OpenEventSource(const std::string &filePath,
+                                              ThreadPool *parsePool) {
+  if (IsBinaryEventFile(filePath)) {
+    return std::make_unique<BinaryEventReader>(filePath);
+  }
+  if (DetectCompression(filePath) != Compression::None) {
+    return std::make_unique<CsvReader>(filePath, CsvReaderMode::Compressed);
+  }
+  if (parsePool != nullptr) {
+    return std::make_unique<ParallelCsvReader>(filePath, *parsePool);
+  }
+  return std::make_unique<CsvReader>(filePath);
+}
+
+} // namespace ArbSim
@@ -0,0 +1,21 @@
+#ifndef EVENT_SOURCE_FACTORY_H
+#define EVENT_SOURCE_FACTORY_H
+
+#include "IEventSource.h"
+#include "ThreadPool.h"
+
+#include <memory>
+#include <string>
+
+namespace ArbSim {
+
+// Opens the right reader for a market data file: files starting with the
+// binary event magic get a BinaryEventReader, gzip / zstd files are
+// decompressed while being read as CSV, anything else is read as CSV.
+// With a parsePool, plain CSV files are parsed in parallel chunks on it.
+std::unique_ptr<IEventSource> OpenEventSource(const std::string &filePath,
+                                              ThreadPool *parsePool = nullptr);
+
+} // namespace ArbSim
+
+#endif // EVENT_SOURCE_FACTORY_H
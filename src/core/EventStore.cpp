@@ -0,0 +1,89 @@
+#include "EventStore.h"
+
+#include "StreamMerger.h"
+
+#include <algorithm>
+
+namespace ArbSim {
+
+EventStore EventStore::Load(IEventSource &source) {
+  EventStore store;
+  std::vector<MarketEvent> batch(kEventBatchSize);
+  size_t n = 0;
+  while ((n = source.ReadEvents(batch.data(), batch.size())) > 0) {
+    store.Reserve(store.Size() + n);
+    for (size_t i = 0; i < n; ++i) {
+      store.Append(batch[i]);
+    }
+  }
+  return store;
+}
+
+EventStore EventStore::LoadMerged(IEventSource &a, IEventSource &b,
+                                  unsigned int seed) {
+  EventStore store;
+  StreamMerger merger(a, b, seed);
+  std::vector<MarketEvent> batch(kEventBatchSize);
+  size_t n = 0;
+  while ((n = merger.ReadBatch(batch.data(), batch.size())) > 0) {
+    store.Reserve(store.Size() + n);
+    for (size_t i = 0; i < n; ++i) {
+      store.Append(batch[i]);
+    }
+  }
+  return store;
+}
+
+void EventStore::Reserve(size_t count) {
+  // Grow geometrically: callers reserve one batch at a time
+  if (count <= sendingTime_.capacity()) {
+    return;
+  }
+  count = std::max(count, 2 * sendingTime_.capacity());
+  sendingTime_.reserve(count);
+  bidTicks_.reserve(count);
+  askTicks_.reserve(count);
+  bidSize_.reserve(count);
+  askSize_.reserve(count);
+  eventTypeId_.reserve(count);
+  instrument_.reserve(count);
+}
+
+void EventStore::Append(const MarketEvent &event) {
+  sendingTime_.push_back(event.sendingTime);
+  bidTicks_.push_back(event.bidTicks);
+  askTicks_.push_back(event.askTicks);
+  bidSize_.push_back(event.bidSize);
+  askSize_.push_back(event.askSize);
+  eventTypeId_.push_back(event.eventTypeId);
+  instrument_.push_back(event.instrumentId);
+}
+
+size_t EventStore::Size() const { return sendingTime_.size(); }
+
+bool EventStore::Empty() const { return sendingTime_.empty(); }
+
+MarketEvent EventStore::Get(size_t i) const {
+  MarketEvent event{};
+  event.sendingTime = sendingTime_[i];
+  event.bidTicks = bidTicks_[i];
+  event.askTicks = askTicks_[i];
+  event.bidSize = bidSize_[i];
+  event.askSize = askSize_[i];
+  event.eventTypeId = eventTypeId_[i];
+  event.instrumentId = instrument_[i];
+  return event;
+}
+
+size_t EventStore::LowerBound(long long time) const {
+  return static_cast<size_t>(
+      std::lower_bound(sendingTime_.begin(), sendingTime_.end(), time) -
+      sendingTime_.begin());
+}
+
+size_t EventStore::MemoryBytes() const {
+  return Size() * (sizeof(int64_t) * 3 + sizeof(int32_t) * 3 +
+                   sizeof(InstrumentId));
+}
+
+} // namespace ArbSim
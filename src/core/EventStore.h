@@ -0,0 +1,61 @@
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include "Constants.h"
+#include "IEventSource.h"
+#include "MarketData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArbSim {
+
+// Columnar (structure-of-arrays) copy of a merged day, loaded once and
+// replayed as often as needed. Each field lives in its own contiguous array;
+// only lookups such as LowerBound() read a single column.
+// SimulationEngine::OnEvents(store, ...) is a scalar per-event loop that
+// reassembles every event with Get().
+class EventStore {
+public:
+  // Every event of source, in order (e.g. a cached merged timeline)
+  static EventStore Load(IEventSource &source);
+  // The StreamMerger merge of two readers
+  static EventStore LoadMerged(IEventSource &a, IEventSource &b,
+                               unsigned int seed = kMergeSeed);
+
+  void Reserve(size_t count);
+  void Append(const MarketEvent &event);
+
+  size_t Size() const;
+  bool Empty() const;
+  // Reassembles event i
+  MarketEvent Get(size_t i) const;
+
+  // Index of the first event with sendingTime >= time
+  size_t LowerBound(long long time) const;
+
+  // Bytes held by the columns
+  size_t MemoryBytes() const;
+
+  const int64_t *SendingTime() const { return sendingTime_.data(); }
+  const int64_t *BidTicks() const { return bidTicks_.data(); }
+  const int64_t *AskTicks() const { return askTicks_.data(); }
+  const int32_t *BidSize() const { return bidSize_.data(); }
+  const int32_t *AskSize() const { return askSize_.data(); }
+  const int32_t *EventTypeId() const { return eventTypeId_.data(); }
+  const InstrumentId *Instrument() const { return instrument_.data(); }
+
+private:
+  std::vector<int64_t> sendingTime_;
+  std::vector<int64_t> bidTicks_;
+  std::vector<int64_t> askTicks_;
+  std::vector<int32_t> bidSize_;
+  std::vector<int32_t> askSize_;
+  std::vector<int32_t> eventTypeId_;
+  std::vector<InstrumentId> instrument_;
+};
+
+} // namespace ArbSim
+
+#endif // EVENT_STORE_H
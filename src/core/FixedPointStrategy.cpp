@@ -0,0 +1,82 @@
+#include "FixedPointStrategy.h"
+#include "Constants.h"
+#include "MarketData.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace ArbSim {
+
+FixedPointStrategy::FixedPointStrategy(const StrategyParams &params)
+    : params_(params) {
+  params_.Validate();
+  // The thresholds Strategy::Decide compares against, as exact tick bounds
+  minEdgeTicks_ = ThresholdTicks(params_.MinArbitrageEdge - kFloatCompareEpsilon);
+  stopLossTicks_ = ThresholdTicks(params_.StopLossPnl);
+}
+
+FixedPointStrategy::FixedPointStrategy(const Config &cfg)
+    : FixedPointStrategy(StrategyParams{
+          cfg.GetDouble("Strategy.MinArbitrageEdge"),
+          cfg.GetDouble("Strategy.StopLossPnl"),
+          cfg.GetInt("Strategy.MaxAbsExposureLots")}) {}
+
+const StrategyParams &FixedPointStrategy::GetParams() const { return params_; }
+
+int64_t FixedPointStrategy::GetMinEdgeTicks() const { return minEdgeTicks_; }
+
+int64_t FixedPointStrategy::GetStopLossTicks() const { return stopLossTicks_; }
+
+StrategyAction FixedPointStrategy::DecideTicks(int64_t sellEdgeTicks,
+                                               int64_t buyEdgeTicks,
+                                               int positionB,
+                                               int64_t pnlTicks) const {
+  // Same order as Strategy::Decide: stop loss, then sell, then buy
+  if (pnlTicks < stopLossTicks_) {
+    return StrategyAction::Flatten;
+  }
+
+  if (sellEdgeTicks >= minEdgeTicks_) {
+    if (std::abs(positionB - 1) > params_.MaxAbsExposureLots) {
+      return StrategyAction::None;
+    }
+    return StrategyAction::SellB;
+  }
+
+  if (buyEdgeTicks >= minEdgeTicks_) {
+    if (std::abs(positionB + 1) > params_.MaxAbsExposureLots) {
+      return StrategyAction::None;
+    }
+    return StrategyAction::BuyB;
+  }
+
+  return StrategyAction::None;
+}
+
+int64_t FixedPointStrategy::ThresholdTicks(double threshold) {
+  constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+  if (std::isnan(threshold)) {
+    return kMax; // no comparison with NaN holds
+  }
+  const double scaled = threshold * static_cast<double>(kPnlMultiplier);
+  if (scaled < -9.0e18) {
+    return kMin;
+  }
+  if (scaled > 9.0e18) {
+    return kMax;
+  }
+  // ceil() is within a tick or two; settle on the exact boundary of the
+  // (monotonic) tick -> price conversion
+  int64_t t = static_cast<int64_t>(std::ceil(scaled));
+  while (TicksToPrice(t) < threshold) {
+    ++t;
+  }
+  while (TicksToPrice(t - 1) >= threshold) {
+    --t;
+  }
+  return t;
+}
+
+} // namespace ArbSim
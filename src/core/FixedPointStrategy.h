@@ -0,0 +1,42 @@
+#ifndef FIXED_POINT_STRATEGY_H
+#define FIXED_POINT_STRATEGY_H
+
+#include "../config/Config.h"
+#include "Istrategy.h"
+#include "StrategyParams.h"
+
+#include <cstdint>
+
+namespace ArbSim {
+
+// Strategy with every price in integer ticks: the edges, the edge threshold,
+// the PnL and the stop loss. The thresholds are converted once, exactly, so
+// DecideTicks() takes the same decisions as Strategy::Decide() on the
+// converted edges and PnL, with no epsilon and no double on the hot path.
+// Used by SimulationEngine through the tick policy interface
+// (IsTickStrategyPolicy).
+class FixedPointStrategy final {
+public:
+  explicit FixedPointStrategy(const StrategyParams &params);
+  explicit FixedPointStrategy(const Config &cfg);
+
+  const StrategyParams &GetParams() const;
+  int64_t GetMinEdgeTicks() const;
+  int64_t GetStopLossTicks() const;
+
+  StrategyAction DecideTicks(int64_t sellEdgeTicks, int64_t buyEdgeTicks,
+                             int positionB, int64_t pnlTicks) const;
+
+  // Smallest tick count whose price is >= threshold, clamped to the int64
+  // range: TicksToPrice(t) >= threshold <=> t >= ThresholdTicks(threshold).
+  static int64_t ThresholdTicks(double threshold);
+
+private:
+  StrategyParams params_;
+  int64_t minEdgeTicks_;  // MinArbitrageEdge - kFloatCompareEpsilon
+  int64_t stopLossTicks_; // StopLossPnl
+};
+
+} // namespace ArbSim
+
+#endif // FIXED_POINT_STRATEGY_H
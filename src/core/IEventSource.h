@@ -0,0 +1,43 @@
+#ifndef I_EVENT_SOURCE_H
+#define I_EVENT_SOURCE_H
+
+#include "MarketData.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace ArbSim {
+
+// A single-instrument stream of market events in file order
+// (CsvReader, BinaryEventReader, ...).
+class IEventSource {
+public:
+  virtual ~IEventSource() = default;
+
+  virtual const std::string &GetFilePath() const = 0;
+
+  // Returns false at end of stream
+  virtual bool ReadNextEvent(MarketEvent &event) = 0;
+
+  // Reads up to max events into out and returns the number read; fewer
+  // than max does not mean end of stream, only 0 does. Events before a
+  // parse error are returned first, the error is thrown by the next call.
+  // Readers override this to avoid a virtual call per event; the default
+  // returns one event per call.
+  virtual size_t ReadEvents(MarketEvent *out, size_t max) {
+    return (max > 0 && ReadNextEvent(out[0])) ? 1 : 0;
+  }
+
+  // Repositions the stream so that no event with sendingTime >= time is
+  // skipped; earlier events may still follow and are left for the caller to
+  // filter. Returns false if the source cannot seek (it is then unchanged).
+  virtual bool SeekToTime(long long /*time*/) { return false; }
+
+  // Reader-specific counters for the Timing Statistics block (optional)
+  virtual void PrintStats(std::ostream & /*out*/) const {}
+};
+
+} // namespace ArbSim
+
+#endif // I_EVENT_SOURCE_H
@@ -3,6 +3,10 @@
 
 #include "StrategyParams.h"
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
 namespace ArbSim {
 
 enum class StrategyAction {
@@ -22,6 +26,44 @@ public:
                                 double currentPnl) const = 0;
 };
 
+// Static interface of a SimulationEngine strategy policy: a move-constructible
+// type with either
+//   StrategyAction Decide(double sellEdge, double buyEdge, int positionB,
+//                         double currentPnl) const;
+// or, to stay in integer ticks end to end (edges and PnL in ticks of
+// 1 / kPnlMultiplier),
+//   StrategyAction DecideTicks(int64_t sellEdgeTicks, int64_t buyEdgeTicks,
+//                              int positionB, int64_t pnlTicks) const;
+// DecideTicks() is preferred when both exist. Deriving from IStrategy is not
+// required; the engine never calls through it.
+template <typename T, typename = void>
+struct IsPriceStrategyPolicy : std::false_type {};
+
+template <typename T>
+struct IsPriceStrategyPolicy<
+    T, std::void_t<decltype(std::declval<const T &>().Decide(0.0, 0.0, 0,
+                                                             0.0))>>
+    : std::is_same<decltype(std::declval<const T &>().Decide(0.0, 0.0, 0,
+                                                             0.0)),
+                   StrategyAction> {};
+
+template <typename T, typename = void>
+struct IsTickStrategyPolicy : std::false_type {};
+
+template <typename T>
+struct IsTickStrategyPolicy<
+    T, std::void_t<decltype(std::declval<const T &>().DecideTicks(
+           int64_t{}, int64_t{}, 0, int64_t{}))>>
+    : std::is_same<decltype(std::declval<const T &>().DecideTicks(
+                       int64_t{}, int64_t{}, 0, int64_t{})),
+                   StrategyAction> {};
+
+template <typename T>
+struct IsStrategyPolicy
+    : std::bool_constant<std::is_move_constructible<T>::value &&
+                         (IsPriceStrategyPolicy<T>::value ||
+                          IsTickStrategyPolicy<T>::value)> {};
+
 } // namespace ArbSim
 
 #endif // I_STRATEGY_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "KWayMerger.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace ArbSim {
+
+KWayMerger::KWayMerger(const std::vector<IEventSource *> &sources,
+                       unsigned int seed)
+    : winner_(0), built_(false),
+      startTime_(std::numeric_limits<long long>::min()),
+      endTime_(std::numeric_limits<long long>::max()), tieBreaker_(seed) {
+  if (sources.empty()) {
+    throw std::invalid_argument("KWayMerger: at least one source required");
+  }
+  inputs_.reserve(sources.size());
+  for (IEventSource *source : sources) {
+    inputs_.emplace_back(*source, kInputBlockEvents);
+  }
+  losers_.resize(sources.size());
+}
+
+void KWayMerger::SetTimeWindow(long long startTime, long long endTime) {
+  startTime_ = startTime;
+  endTime_ = endTime;
+}
+
+size_t KWayMerger::GetSourceCount() const { return inputs_.size(); }
+
+bool KWayMerger::Live(size_t i) const { return inputs_[i].HasEvent(); }
+
+bool KWayMerger::Beats(size_t x, size_t y) const {
+  // An exhausted source loses every match, with no tie-break
+  if (!Live(x)) {
+    return false;
+  }
+  if (!Live(y)) {
+    return true;
+  }
+
+  const long long tx = inputs_[x].Head().sendingTime;
+  const long long ty = inputs_[y].Head().sendingTime;
+  if (tx != ty) {
+    return tx < ty;
+  }
+  // Timestamps are equal: each head's (seed, timestamp, source, ordinal)
+  // key decides
+  return tieBreaker_.PickFirst(tx, x, inputs_[x].HeadOrdinal(), y,
+                               inputs_[y].HeadOrdinal());
+}
+
+void KWayMerger::Build() {
+  for (BufferedInput &input : inputs_) {
+    input.Refill(startTime_, endTime_);
+  }
+
+  // Play the initial tournament bottom-up; winners[] only lives here
+  const size_t k = inputs_.size();
+  std::vector<size_t> winners(2 * k);
+  for (size_t i = 0; i < k; ++i) {
+    winners[k + i] = i;
+  }
+  for (size_t node = k - 1; node >= 1; --node) {
+    const size_t left = winners[2 * node];
+    const size_t right = winners[2 * node + 1];
+    if (Beats(left, right)) {
+      winners[node] = left;
+      losers_[node] = right;
+    } else {
+      winners[node] = right;
+      losers_[node] = left;
+    }
+  }
+  winner_ = (k == 1) ? 0 : winners[1];
+  built_ = true;
+}
+
+size_t KWayMerger::ReadBatch(MarketEvent *out, size_t max) {
+  if (!built_) {
+    Build();
+  }
+
+  const size_t k = inputs_.size();
+  size_t n = 0;
+  while (n < max) {
+    BufferedInput &top = inputs_[winner_];
+    if (!top.HasEvent()) {
+      break; // the overall winner is exhausted: so is everyone else
+    }
+    out[n++] = top.Take();
+    if (!top.HasEvent()) {
+      top.Refill(startTime_, endTime_);
+    }
+
+    // Replay the path from the winner's leaf to the root
+    size_t candidate = winner_;
+    for (size_t node = (k + winner_) / 2; node >= 1; node /= 2) {
+      if (Beats(losers_[node], candidate)) {
+        std::swap(losers_[node], candidate);
+      }
+    }
+    winner_ = candidate;
+  }
+  return n;
+}
+
+bool KWayMerger::ReadNext(MarketEvent &outEvent) {
+  return ReadBatch(&outEvent, 1) == 1;
+}
+
+} // namespace ArbSim
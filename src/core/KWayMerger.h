@@ -0,0 +1,59 @@
+#ifndef KWAY_MERGER_H
+#define KWAY_MERGER_H
+
+#include "BufferedInput.h"
+#include "IEventSource.h"
+#include "MarketData.h"
+
+#include "TieBreak.h"
+
+#include <limits>
+#include <vector>
+
+namespace ArbSim {
+
+// Merges any number of time-sorted sources with a loser tree: each event
+// costs one leaf-to-root replay, O(log k) comparisons.
+//
+// Equal sendingTime is resolved like StreamMerger: each tied head is ranked
+// by its TieBreakKey (seed, sendingTime, source index, ordinal within that
+// source's events at the timestamp), so the order does not depend on the
+// shape of the tree or on which matches were played. With two sources the
+// output is identical to StreamMerger for the same seed.
+class KWayMerger {
+public:
+  static constexpr size_t kInputBlockEvents = 1024;
+
+  // Sources are not owned and must outlive the merger
+  explicit KWayMerger(const std::vector<IEventSource *> &sources,
+                      unsigned int seed = 42);
+
+  bool ReadNext(MarketEvent &outEvent);
+  size_t ReadBatch(MarketEvent *out, size_t max);
+
+  // Same semantics as StreamMerger::SetTimeWindow; call before reading
+  void SetTimeWindow(long long startTime, long long endTime);
+
+  size_t GetSourceCount() const;
+
+private:
+  std::vector<BufferedInput> inputs_;
+  // losers_[node] for internal nodes 1..k-1; leaf i sits at position k + i
+  std::vector<size_t> losers_;
+  size_t winner_;
+  bool built_;
+
+  long long startTime_;
+  long long endTime_;
+
+  TieBreaker tieBreaker_;
+
+  bool Live(size_t i) const;
+  // True if source x's head goes before source y's head
+  bool Beats(size_t x, size_t y) const;
+  void Build();
+};
+
+} // namespace ArbSim
+
+#endif // KWAY_MERGER_H
@@ -0,0 +1,125 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ArbSim {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &filePath)
+    : data_(nullptr), size_(0), fileHandle_(INVALID_HANDLE_VALUE),
+      mappingHandle_(nullptr) {
+  HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("MappedFile: Failed to open file: " + filePath);
+  }
+  fileHandle_ = file;
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("MappedFile: Failed to stat file: " + filePath);
+  }
+  size_ = static_cast<size_t>(size.QuadPart);
+
+  if (size_ == 0) {
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    throw std::runtime_error("MappedFile: Failed to map file: " + filePath);
+  }
+  mappingHandle_ = mapping;
+
+  data_ = static_cast<const char *>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    throw std::runtime_error("MappedFile: Failed to map file: " + filePath);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mappingHandle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(mappingHandle_));
+  }
+  if (fileHandle_ != INVALID_HANDLE_VALUE) {
+    CloseHandle(static_cast<HANDLE>(fileHandle_));
+  }
+}
+
+void MappedFile::AdviseSequential() const {
+  // FILE_FLAG_SEQUENTIAL_SCAN on open already covers this on Windows
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filePath)
+    : data_(nullptr), size_(0), fd_(-1) {
+  fd_ = ::open(filePath.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("MappedFile: Failed to open file: " + filePath);
+  }
+
+  struct stat st {};
+  if (::fstat(fd_, &st) != 0) {
+    ::close(fd_);
+    throw std::runtime_error("MappedFile: Failed to stat file: " + filePath);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+
+  if (size_ == 0) {
+    return;
+  }
+
+  void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (addr == MAP_FAILED) {
+    ::close(fd_);
+    throw std::runtime_error("MappedFile: Failed to map file: " + filePath);
+  }
+  data_ = static_cast<const char *>(addr);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char *>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+void MappedFile::AdviseSequential() const {
+  if (data_ != nullptr) {
+    ::madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+  }
+}
+
+#endif
+
+const char *MappedFile::Data() const { return data_; }
+
+size_t MappedFile::Size() const { return size_; }
+
+} // namespace ArbSim
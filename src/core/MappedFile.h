@@ -0,0 +1,41 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace ArbSim {
+
+// Read-only memory mapping of a whole file (RAII).
+// An empty file is valid and maps to Data() == nullptr, Size() == 0.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &filePath);
+  ~MappedFile();
+
+  // Non-copyable (owns the mapping)
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *Data() const;
+  size_t Size() const;
+
+  // Hint to the OS that the mapping will be read front to back
+  // (madvise(MADV_SEQUENTIAL) on POSIX, no-op elsewhere).
+  void AdviseSequential() const;
+
+private:
+  const char *data_;
+  size_t size_;
+
+#ifdef _WIN32
+  void *fileHandle_;
+  void *mappingHandle_;
+#else
+  int fd_;
+#endif
+};
+
+} // namespace ArbSim
+
+#endif // MAPPED_FILE_H
@@ -1,12 +1,16 @@
 #ifndef MARKET_DATA_H
 #define MARKET_DATA_H
 
+#include "Constants.h"
+
+#include <cmath>
+#include <cstdint>
 #include <string>
 
 namespace ArbSim
 {
 
-enum class InstrumentId
+enum class InstrumentId : uint8_t
 {
     FutureA,
     FutureB,
@@ -19,17 +23,36 @@ enum class Side
     Sell
 };
 
+// Prices travel as integer ticks of 1 / kPnlMultiplier (the PnlTracker
+// scale). For prices with up to kPnlDecimals decimals TicksToPrice() returns
+// exactly the double strtod would have parsed.
+inline int64_t PriceToTicks(double price)
+{
+    return std::llround(price * static_cast<double>(kPnlMultiplier));
+}
+
+inline double TicksToPrice(int64_t ticks)
+{
+    return static_cast<double>(ticks) / static_cast<double>(kPnlMultiplier);
+}
+
+// Widest fields first: 40 bytes with no interior padding (was 48)
 struct MarketEvent
 {
     long long sendingTime;
+    int64_t bidTicks;
+    int64_t askTicks;
+    int32_t bidSize;
+    int32_t askSize;
+    int32_t eventTypeId;
     InstrumentId instrumentId;
-    int eventTypeId;
-    int bidSize;
-    double bid;
-    double ask;
-    int askSize;
+
+    double Bid() const { return TicksToPrice(bidTicks); }
+    double Ask() const { return TicksToPrice(askTicks); }
 };
 
+static_assert(sizeof(MarketEvent) == 40, "MarketEvent layout");
+
 inline std::string InstrumentToString(InstrumentId id)
 {
     switch (id)
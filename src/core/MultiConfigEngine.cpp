@@ -0,0 +1,270 @@
+#include "MultiConfigEngine.h"
+
+#include "CsvScanner.h"
+#include "FixedPointStrategy.h"
+#include "MarketData.h"
+#include "PnlTracker.h"
+
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define ARBSIM_LANES_X86 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define ARBSIM_TARGET_AVX2
+#define ARBSIM_LANES_INLINE __forceinline
+#else
+#define ARBSIM_TARGET_AVX2 __attribute__((target("avx2")))
+#define ARBSIM_LANES_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace ArbSim {
+
+namespace {
+
+// The lane kernels select with masks instead of branching on lane data, so
+// every loop over a block compiles to vector code. Baseline x86-64 has no
+// 64-bit vector compare, so the replay loop is also built for AVX2 and
+// picked at runtime, as in CsvScanner.
+
+ARBSIM_LANES_INLINE int64_t Select(int64_t mask, int64_t a, int64_t b) {
+  return (a & mask) | (b & ~mask);
+}
+
+ARBSIM_LANES_INLINE int64_t Abs(int64_t v) {
+  const int64_t sign = v >> 63;
+  return (v ^ sign) - sign;
+}
+
+template <class Block>
+constexpr size_t kLanes = std::extent<decltype(Block::stopped)>::value;
+
+// Marks every running lane of the block to the new B mid
+template <class Block>
+ARBSIM_LANES_INLINE void MarkBlock(Block &b, int64_t mid) {
+  for (size_t k = 0; k < kLanes<Block>; ++k) {
+    // A stopped lane keeps its last mark (SimulationEngine stops reading)
+    const int64_t running = b.stopped[k] - 1; // all ones while running
+    const int64_t t =
+        Select(running, b.cash[k] + b.position[k] * mid, b.total[k]);
+    b.total[k] = t;
+    b.best[k] = t > b.best[k] ? t : b.best[k];
+    b.worst[k] = t < b.worst[k] ? t : b.worst[k];
+  }
+}
+
+// One strategy decision per running lane; returns how many lanes stopped
+template <class Block>
+ARBSIM_LANES_INLINE int64_t DecideBlock(Block &b, int64_t sellEdge,
+                                        int64_t buyEdge, int64_t bidB,
+                                        int64_t askB, int64_t bidOk,
+                                        int64_t askOk, int64_t mid,
+                                        int64_t consumed) {
+  int64_t newlyStopped = 0;
+  for (size_t k = 0; k < kLanes<Block>; ++k) {
+    const int64_t active = 1 - b.stopped[k];
+    const int64_t pos = b.position[k];
+
+    // FixedPointStrategy::DecideTicks: stop loss first, then the sell edge,
+    // then the buy edge; an entry over the exposure limit is no action
+    const int64_t flatten = active & (b.total[k] < b.stop[k] ? 1 : 0);
+    const int64_t sellSignal =
+        active & (1 - flatten) & (sellEdge >= b.minEdge[k] ? 1 : 0);
+    const int64_t buySignal = active & (1 - flatten) & (1 - sellSignal) &
+                              (buyEdge >= b.minEdge[k] ? 1 : 0);
+    const int64_t sell = sellSignal & (Abs(pos - 1) <= b.maxLots[k] ? 1 : 0);
+    const int64_t buy = buySignal & (Abs(pos + 1) <= b.maxLots[k] ? 1 : 0);
+
+    // SimulationEngine: no size on the B side drops the trade
+    b.droppedSells[k] += sell & (1 - bidOk);
+    b.droppedBuys[k] += buy & (1 - askOk);
+    const int64_t doSell = sell & bidOk;
+    const int64_t doBuy = buy & askOk;
+
+    // Flatten trades |pos| at mid: cash moves by pos * mid either way
+    const int64_t cash = b.cash[k] + (-doSell & bidB) - (-doBuy & askB) +
+                         (-flatten & (pos * mid));
+    b.cash[k] = cash;
+    b.tradedLots[k] += doSell + doBuy + (-flatten & Abs(pos));
+    const int64_t newPos = (flatten - 1) & (pos + doBuy - doSell);
+    b.position[k] = newPos;
+    const int64_t absNew = Abs(newPos);
+    b.maxExposure[k] = absNew > b.maxExposure[k] ? absNew : b.maxExposure[k];
+
+    // Re-marking an unchanged running lane at the same mid is a no-op, so
+    // every running lane is marked (as after a trade)
+    const int64_t t = Select(-active, cash + newPos * mid, b.total[k]);
+    b.total[k] = t;
+    b.best[k] = t > b.best[k] ? t : b.best[k];
+    b.worst[k] = t < b.worst[k] ? t : b.worst[k];
+
+    b.stopped[k] |= flatten;
+    b.events[k] = Select(-flatten, consumed, b.events[k]);
+    newlyStopped += flatten;
+  }
+  return newlyStopped;
+}
+
+// End of day: lanes still running close at the last mid
+template <class Block> void CloseBlockAtMid(Block &b, int64_t mid) {
+  for (size_t k = 0; k < kLanes<Block>; ++k) {
+    if (b.stopped[k] || b.position[k] == 0) {
+      continue;
+    }
+    const int64_t pos = b.position[k];
+    b.cash[k] += pos * mid;
+    b.tradedLots[k] += Abs(pos);
+    b.position[k] = 0;
+    b.total[k] = b.cash[k];
+    b.best[k] = b.total[k] > b.best[k] ? b.total[k] : b.best[k];
+    b.worst[k] = b.total[k] < b.worst[k] ? b.total[k] : b.worst[k];
+  }
+}
+
+struct ReplayEnd {
+  size_t consumed;
+  bool hasMid;
+  int64_t mid;
+};
+
+// Replays [begin, end) through all blocks until no lane is running. The as-of
+// quotes, mid and edges are computed once per event for every lane.
+template <class Block>
+ARBSIM_LANES_INLINE ReplayEnd ReplayLanes(Block *blocks, size_t blockCount,
+                                          size_t running,
+                                          const EventStore &store,
+                                          size_t begin, size_t end) {
+  const int64_t *bid = store.BidTicks();
+  const int64_t *ask = store.AskTicks();
+  const int32_t *bidSize = store.BidSize();
+  const int32_t *askSize = store.AskSize();
+  const InstrumentId *instrument = store.Instrument();
+
+  bool hasA = false;
+  bool hasB = false;
+  int64_t bidA = 0;
+  int64_t askA = 0;
+  int64_t bidB = 0;
+  int64_t askB = 0;
+  int64_t bidOkB = 0;
+  int64_t askOkB = 0;
+  int64_t mid = 0;
+
+  size_t i = begin;
+  for (; i < end && running > 0; ++i) {
+    if (instrument[i] == InstrumentId::FutureA) {
+      hasA = true;
+      bidA = bid[i];
+      askA = ask[i];
+    } else if (instrument[i] == InstrumentId::FutureB) {
+      hasB = true;
+      bidB = bid[i];
+      askB = ask[i];
+      bidOkB = bidSize[i] >= 1 ? 1 : 0;
+      askOkB = askSize[i] >= 1 ? 1 : 0;
+      mid = PnlTracker::MidTicks(bidB, askB);
+      for (size_t j = 0; j < blockCount; ++j) {
+        MarkBlock(blocks[j], mid);
+      }
+    }
+
+    if (!hasA || !hasB) {
+      continue;
+    }
+
+    const int64_t consumed = static_cast<int64_t>(i + 1 - begin);
+    for (size_t j = 0; j < blockCount; ++j) {
+      running -= static_cast<size_t>(DecideBlock(blocks[j], bidB - askA,
+                                                 bidA - askB, bidB, askB,
+                                                 bidOkB, askOkB, mid,
+                                                 consumed));
+    }
+  }
+  return ReplayEnd{i - begin, hasB, mid};
+}
+
+template <class Block>
+ReplayEnd ReplayPortable(Block *blocks, size_t blockCount, size_t running,
+                         const EventStore &store, size_t begin, size_t end) {
+  return ReplayLanes(blocks, blockCount, running, store, begin, end);
+}
+
+#ifdef ARBSIM_LANES_X86
+template <class Block>
+ARBSIM_TARGET_AVX2 ReplayEnd ReplayAvx2(Block *blocks, size_t blockCount,
+                                        size_t running,
+                                        const EventStore &store, size_t begin,
+                                        size_t end) {
+  return ReplayLanes(blocks, blockCount, running, store, begin, end);
+}
+#endif
+
+} // namespace
+
+MultiConfigEngine::MultiConfigEngine(const std::vector<StrategyParams> &params)
+    : params_(params),
+      blocks_((params.size() + kLaneBlock - 1) / kLaneBlock, LaneBlock{}),
+      totalEvents_(0) {
+  for (size_t k = 0; k < blocks_.size() * kLaneBlock; ++k) {
+    LaneBlock &b = blocks_[k / kLaneBlock];
+    const size_t lane = k % kLaneBlock;
+    if (k >= params_.size()) {
+      b.stopped[lane] = 1;
+      continue;
+    }
+    // Each lane runs the FixedPointStrategy decision
+    const FixedPointStrategy strategy(params_[k]);
+    b.minEdge[lane] = strategy.GetMinEdgeTicks();
+    b.stop[lane] = strategy.GetStopLossTicks();
+    b.maxLots[lane] = params_[k].MaxAbsExposureLots;
+  }
+}
+
+size_t MultiConfigEngine::GetLaneCount() const { return params_.size(); }
+
+void MultiConfigEngine::Run(const EventStore &store, size_t begin,
+                            size_t end) {
+  // The scanner's AVX2 probe answers the same question for the lane loops
+#ifdef ARBSIM_LANES_X86
+  static const bool useAvx2 = DetectScannerKind() == ScannerKind::Avx2;
+  const ReplayEnd last =
+      useAvx2 ? ReplayAvx2(blocks_.data(), blocks_.size(), params_.size(),
+                           store, begin, end)
+              : ReplayPortable(blocks_.data(), blocks_.size(), params_.size(),
+                               store, begin, end);
+#else
+  const ReplayEnd last = ReplayPortable(blocks_.data(), blocks_.size(),
+                                        params_.size(), store, begin, end);
+#endif
+  totalEvents_ = last.consumed;
+
+  if (totalEvents_ > 0 && last.hasMid) {
+    for (LaneBlock &b : blocks_) {
+      CloseBlockAtMid(b, last.mid);
+    }
+  }
+}
+
+std::vector<SweepResult> MultiConfigEngine::Results() const {
+  std::vector<SweepResult> results(params_.size());
+  for (size_t k = 0; k < params_.size(); ++k) {
+    const LaneBlock &b = blocks_[k / kLaneBlock];
+    const size_t lane = k % kLaneBlock;
+    SweepResult &r = results[k];
+    r.params = params_[k];
+    r.stopped = b.stopped[lane] != 0;
+    r.events = r.stopped ? static_cast<uint64_t>(b.events[lane]) : totalEvents_;
+    r.totalPnl = TicksToPrice(b.total[lane]);
+    r.bestPnl = TicksToPrice(b.best[lane]);
+    r.worstPnl = TicksToPrice(b.worst[lane]);
+    r.maxExposure = static_cast<int>(b.maxExposure[lane]);
+    r.tradedLots = static_cast<int>(b.tradedLots[lane]);
+    r.droppedBuys = static_cast<size_t>(b.droppedBuys[lane]);
+    r.droppedSells = static_cast<size_t>(b.droppedSells[lane]);
+  }
+  return results;
+}
+
+} // namespace ArbSim
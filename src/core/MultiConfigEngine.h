@@ -0,0 +1,69 @@
+#ifndef MULTI_CONFIG_ENGINE_H
+#define MULTI_CONFIG_ENGINE_H
+
+#include "EventStore.h"
+#include "ParameterSweep.h"
+#include "StrategyParams.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArbSim {
+
+// Runs K parameter sets in lockstep over one event stream. Each set is a
+// "lane": its position, cash and PnL live in per-lane int64 arrays, and
+// every event updates all lanes with the same branch-free arithmetic
+// (SIMD-friendly loops over the lanes). The event-side work (as-of quotes,
+// mid, edges) is done once per event for all lanes.
+//
+// Each lane runs FixedPointStrategy's decision and reproduces a
+// SimulationEngine over the same events, including stop loss and end-of-day
+// close: Results() equals RunSweep() for the same grid. Trades are not
+// logged.
+class MultiConfigEngine {
+public:
+  explicit MultiConfigEngine(const std::vector<StrategyParams> &params);
+
+  // Replays store events [begin, end), then closes the open lanes at mid as
+  // at end of day. Call once per engine.
+  void Run(const EventStore &store, size_t begin, size_t end);
+
+  size_t GetLaneCount() const;
+  std::vector<SweepResult> Results() const;
+
+private:
+  // Lanes are stored in blocks of kLaneBlock: every loop over a block has a
+  // fixed trip count over members of one object, which the compiler turns
+  // into straight vector code (the lane kernels live in the .cpp). Padding
+  // lanes start stopped.
+  static constexpr size_t kLaneBlock = 8;
+
+  struct alignas(64) LaneBlock {
+    // Parameters, in ticks / lots
+    int64_t minEdge[kLaneBlock];
+    int64_t stop[kLaneBlock];
+    int64_t maxLots[kLaneBlock];
+
+    // State (PnlTracker / SimulationEngine fields)
+    int64_t position[kLaneBlock];
+    int64_t cash[kLaneBlock];
+    int64_t total[kLaneBlock];
+    int64_t best[kLaneBlock];
+    int64_t worst[kLaneBlock];
+    int64_t maxExposure[kLaneBlock];
+    int64_t tradedLots[kLaneBlock];
+    int64_t droppedBuys[kLaneBlock];
+    int64_t droppedSells[kLaneBlock];
+    int64_t stopped[kLaneBlock]; // 0 or 1
+    int64_t events[kLaneBlock];  // events consumed, set when the lane stops
+  };
+
+  std::vector<StrategyParams> params_;
+  std::vector<LaneBlock> blocks_;
+  uint64_t totalEvents_;
+};
+
+} // namespace ArbSim
+
+#endif // MULTI_CONFIG_ENGINE_H
@@ -0,0 +1,107 @@
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ArbSim {
+
+OutputBuffer::OutputBuffer() : fd_(-1), size_(0) {}
+
+OutputBuffer::OutputBuffer(int fd, size_t capacity)
+    : fd_(fd), buffer_(std::max(capacity, kMaxNumberChars)), size_(0) {}
+
+OutputBuffer::~OutputBuffer() {
+  try {
+    Flush();
+  } catch (...) {
+    // Destructors must not throw; call Flush() explicitly to see errors
+  }
+}
+
+void OutputBuffer::Append(const char *data, size_t size) {
+  if (fd_ >= 0 && size_ + size > buffer_.size()) {
+    Flush();
+    if (size > buffer_.size()) {
+      // Larger than the whole buffer: one write straight from the caller
+      WriteAll(data, size);
+      return;
+    }
+  }
+  std::memcpy(Reserve(size), data, size);
+  size_ += size;
+}
+
+void OutputBuffer::AppendDouble(double value, int precision) {
+  const size_t room = kMaxNumberChars + static_cast<size_t>(precision);
+  char *p = Reserve(room);
+  const std::to_chars_result r = std::to_chars(
+      p, p + room, value, std::chars_format::general, precision);
+  size_ += static_cast<size_t>(r.ptr - p);
+}
+
+void OutputBuffer::AppendDouble(double value) {
+  char *p = Reserve(kMaxNumberChars);
+  const std::to_chars_result r = std::to_chars(p, p + kMaxNumberChars, value);
+  size_ += static_cast<size_t>(r.ptr - p);
+}
+
+char *OutputBuffer::Reserve(size_t n) {
+  if (size_ + n > buffer_.size()) {
+    if (fd_ >= 0) {
+      Flush();
+    }
+    if (n > buffer_.size() - size_) {
+      // In memory (or an item wider than the buffer): grow geometrically
+      buffer_.resize(std::max(size_ + n, 2 * buffer_.size()));
+    }
+  }
+  return buffer_.data() + size_;
+}
+
+void OutputBuffer::Flush() {
+  if (fd_ < 0 || size_ == 0) {
+    return;
+  }
+  // Clear first so a failed write is not repeated by the destructor
+  const size_t size = size_;
+  size_ = 0;
+  WriteAll(buffer_.data(), size);
+}
+
+void OutputBuffer::WriteAll(const char *data, size_t size) {
+  // One write() unless the descriptor takes less (pipes, signals)
+  while (size > 0) {
+#ifdef _WIN32
+    const int n = _write(fd_, data, static_cast<unsigned int>(size));
+#else
+    const ssize_t n = write(fd_, data, size);
+#endif
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw std::runtime_error("OutputBuffer: Failed to write " +
+                               std::to_string(size) + " bytes to fd " +
+                               std::to_string(fd_));
+    }
+    data += n;
+    size -= static_cast<size_t>(n);
+  }
+}
+
+std::string_view OutputBuffer::View() const {
+  return std::string_view(buffer_.data(), size_);
+}
+
+void OutputBuffer::Clear() { size_ = 0; }
+
+} // namespace ArbSim
@@ -0,0 +1,92 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include "Constants.h"
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ArbSim {
+
+constexpr int kStdoutFd = 1;
+
+// Output text formatted with std::to_chars into one reusable buffer. With a
+// file descriptor, the buffer goes out in a single write() per Flush() (and
+// whenever the next item does not fit); without one, it only collects, and
+// View() returns the text.
+//
+// operator<< produces the same bytes as a default-formatted std::ostream:
+// integers in decimal, doubles like printf "%g" (precision 6). Nothing is
+// allocated after construction when writing to a descriptor.
+class OutputBuffer {
+public:
+  // Collects in memory
+  OutputBuffer();
+  explicit OutputBuffer(int fd, size_t capacity = kOutputBufferSize);
+  // Flushes; errors are dropped, call Flush() to see them
+  ~OutputBuffer();
+
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+  void Append(const char *data, size_t size);
+
+  // `value` as printf "%.<precision>g"
+  void AppendDouble(double value, int precision);
+  // Shortest text that reads back as exactly `value` (JSON numbers)
+  void AppendDouble(double value);
+
+  OutputBuffer &operator<<(std::string_view text) {
+    Append(text.data(), text.size());
+    return *this;
+  }
+
+  OutputBuffer &operator<<(char c) {
+    Append(&c, 1);
+    return *this;
+  }
+
+  OutputBuffer &operator<<(double value) {
+    AppendDouble(value, kStreamPrecision);
+    return *this;
+  }
+
+  template <typename T, typename = std::enable_if_t<
+                            std::is_integral<T>::value &&
+                            !std::is_same<T, bool>::value &&
+                            !std::is_same<T, char>::value>>
+  OutputBuffer &operator<<(T value) {
+    char *p = Reserve(kMaxNumberChars);
+    const std::to_chars_result r = std::to_chars(p, p + kMaxNumberChars, value);
+    size_ += static_cast<size_t>(r.ptr - p);
+    return *this;
+  }
+
+  // Writes the buffered text to the descriptor (no-op in memory); throws
+  // std::runtime_error if the write fails
+  void Flush();
+
+  std::string_view View() const;
+  void Clear();
+
+private:
+  // std::ostream's default precision
+  static constexpr int kStreamPrecision = 6;
+  // Longest integer, or double beyond its digits: sign, point, exponent
+  static constexpr size_t kMaxNumberChars = 32;
+
+  int fd_; // -1 in memory
+  std::vector<char> buffer_;
+  size_t size_;
+
+  // Room for n more bytes at the end of the text
+  char *Reserve(size_t n);
+  void WriteAll(const char *data, size_t size);
+};
+
+} // namespace ArbSim
+
+#endif // OUTPUT_BUFFER_H
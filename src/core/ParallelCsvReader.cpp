@@ -0,0 +1,137 @@
+#include "ParallelCsvReader.h"
+#include "CsvReader.h"
+#include "TimeIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace ArbSim {
+
+ParallelCsvReader::ParallelCsvReader(const std::string &filePath,
+                                     ThreadPool &pool, size_t chunkBytes)
+    : filePath_(filePath), pool_(pool),
+      chunkBytes_(chunkBytes > 0 ? chunkBytes : 1),
+      // Enough queued chunks to keep every worker busy while one is consumed
+      maxInFlight_(2 * pool.Size() + 1), nextChunk_(nullptr), mapEnd_(nullptr),
+      pos_(0) {
+  try {
+    mapped_ = std::make_unique<MappedFile>(filePath_);
+  } catch (const std::runtime_error &) {
+    throw std::runtime_error("CsvReader: Failed to open file: " + filePath_);
+  }
+  mapped_->AdviseSequential();
+  nextChunk_ = mapped_->Data();
+  mapEnd_ = nextChunk_ + mapped_->Size();
+}
+
+ParallelCsvReader::~ParallelCsvReader() { WaitInFlight(); }
+
+const std::string &ParallelCsvReader::GetFilePath() const { return filePath_; }
+
+ParallelCsvReader::Block ParallelCsvReader::ParseChunk(const std::string &name,
+                                                       const char *begin,
+                                                       const char *end) {
+  Block block;
+  // Rows are ~40 bytes; avoids most regrowth of the block
+  block.events.reserve(static_cast<size_t>(end - begin) / 32);
+  try {
+    CsvReader reader(name, begin, static_cast<size_t>(end - begin));
+    MarketEvent ev{};
+    while (reader.ReadNextEvent(ev)) {
+      block.events.push_back(ev);
+    }
+  } catch (...) {
+    block.error = std::current_exception();
+  }
+  return block;
+}
+
+void ParallelCsvReader::SubmitChunks() {
+  while (inFlight_.size() < maxInFlight_ && nextChunk_ < mapEnd_) {
+    const char *begin = nextChunk_;
+    const char *end = mapEnd_;
+    if (static_cast<size_t>(mapEnd_ - begin) > chunkBytes_) {
+      // Extend to the end of the line the target size falls in
+      const char *cut = begin + chunkBytes_;
+      const void *nl = std::memchr(cut, '\n', mapEnd_ - cut);
+      end = nl != nullptr ? static_cast<const char *>(nl) + 1 : mapEnd_;
+    }
+    nextChunk_ = end;
+
+    inFlight_.push_back(pool_.Submit(
+        [this, begin, end]() { return ParseChunk(filePath_, begin, end); }));
+  }
+}
+
+bool ParallelCsvReader::AcquireNextBlock() {
+  for (;;) {
+    SubmitChunks();
+    if (inFlight_.empty()) {
+      return false;
+    }
+
+    current_ = inFlight_.front().get();
+    inFlight_.pop_front();
+    pos_ = 0;
+
+    if (!current_.events.empty()) {
+      return true;
+    }
+    if (current_.error) {
+      std::rethrow_exception(current_.error);
+    }
+    // Chunk of blank lines only: keep going
+  }
+}
+
+bool ParallelCsvReader::ReadNextEvent(MarketEvent &event) {
+  if (pos_ == current_.events.size()) {
+    // Once an error was delivered the stream stays failed
+    if (current_.error) {
+      std::rethrow_exception(current_.error);
+    }
+    if (!AcquireNextBlock()) {
+      return false;
+    }
+  }
+
+  event = current_.events[pos_++];
+  return true;
+}
+
+size_t ParallelCsvReader::ReadEvents(MarketEvent *out, size_t max) {
+  // At most the rest of one block per call, so an error is only rethrown by
+  // a call that has nothing else to return
+  if (pos_ == current_.events.size()) {
+    if (current_.error) {
+      std::rethrow_exception(current_.error);
+    }
+    if (!AcquireNextBlock()) {
+      return 0;
+    }
+  }
+
+  const size_t take = std::min(max, current_.events.size() - pos_);
+  std::copy_n(current_.events.data() + pos_, take, out);
+  pos_ += take;
+  return take;
+}
+
+bool ParallelCsvReader::SeekToTime(long long time) {
+  WaitInFlight();
+  current_ = Block{};
+  pos_ = 0;
+  nextChunk_ =
+      mapped_->Data() + TimeIndex::LoadOrBuild(filePath_).FindOffset(time);
+  return true;
+}
+
+void ParallelCsvReader::WaitInFlight() {
+  for (std::future<Block> &f : inFlight_) {
+    f.wait();
+  }
+  inFlight_.clear();
+}
+
+} // namespace ArbSim
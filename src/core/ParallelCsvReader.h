@@ -0,0 +1,74 @@
+#ifndef PARALLEL_CSV_READER_H
+#define PARALLEL_CSV_READER_H
+
+#include "IEventSource.h"
+#include "MappedFile.h"
+#include "MarketData.h"
+#include "ThreadPool.h"
+
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+// Parses one large CSV file on a thread pool. The mapped file is cut into
+// chunks at newline boundaries; each chunk is parsed by a CsvReader over
+// that byte range, and the resulting event blocks are delivered strictly in
+// file order, so the output is identical to a single CsvReader.
+//
+// A parse error is rethrown, with the same message (including the line),
+// only after every event that precedes the bad line has been delivered.
+class ParallelCsvReader : public IEventSource {
+public:
+  static constexpr size_t kDefaultChunkBytes = 4 * 1024 * 1024;
+
+  // The pool must outlive the reader; it can be shared by several readers.
+  ParallelCsvReader(const std::string &filePath, ThreadPool &pool,
+                    size_t chunkBytes = kDefaultChunkBytes);
+  // Waits for the chunks still being parsed (they read the mapping)
+  ~ParallelCsvReader() override;
+
+  ParallelCsvReader(const ParallelCsvReader &) = delete;
+  ParallelCsvReader &operator=(const ParallelCsvReader &) = delete;
+
+  const std::string &GetFilePath() const override;
+  bool ReadNextEvent(MarketEvent &event) override;
+  size_t ReadEvents(MarketEvent *out, size_t max) override;
+  bool SeekToTime(long long time) override;
+
+private:
+  struct Block {
+    std::vector<MarketEvent> events;
+    std::exception_ptr error; // thrown after events
+  };
+
+  std::string filePath_;
+  ThreadPool &pool_;
+  const size_t chunkBytes_;
+  const size_t maxInFlight_;
+  std::unique_ptr<MappedFile> mapped_;
+
+  // Start of the next chunk to submit
+  const char *nextChunk_;
+  const char *mapEnd_;
+
+  std::deque<std::future<Block>> inFlight_;
+  Block current_;
+  size_t pos_;
+
+  // Submits chunks until maxInFlight_ are queued or the file is split
+  void SubmitChunks();
+  bool AcquireNextBlock();
+  void WaitInFlight();
+
+  static Block ParseChunk(const std::string &name, const char *begin,
+                          const char *end);
+};
+
+} // namespace ArbSim
+
+#endif // PARALLEL_CSV_READER_H
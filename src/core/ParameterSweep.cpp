@@ -0,0 +1,114 @@
+#include "ParameterSweep.h"
+
+#include "MultiConfigEngine.h"
+#include "PnlTracker.h"
+#include "SimulationEngine.h"
+#include "Strategy.h"
+#include "TradeLog.h"
+
+#include <algorithm>
+#include <future>
+#include <ostream>
+
+namespace ArbSim {
+
+namespace {
+
+SweepResult RunOne(const EventStore &store, size_t begin, size_t end,
+                   const StrategyParams &params) {
+  // Trades are not reported per set, only the summary: count them instead
+  // of formatting every fill into a log nobody reads
+  CountingTradeSink trades;
+  SimulationEngine engine(Strategy(params), PnlTracker(), trades);
+
+  const size_t done = engine.OnEvents(store, begin, end);
+  if (done > 0) {
+    engine.OnEndOfDay(store.SendingTime()[begin + done - 1]);
+  }
+
+  const PnlTracker &pnl = engine.GetPnl();
+  SweepResult result{};
+  result.params = params;
+  result.events = done;
+  result.stopped = engine.IsStopped();
+  result.totalPnl = pnl.GetTotalPnl();
+  result.bestPnl = pnl.GetBestPnl();
+  result.worstPnl = pnl.GetWorstPnl();
+  result.maxExposure = pnl.GetMaxAbsExposure();
+  result.tradedLots = pnl.GetTradedLots();
+  result.droppedBuys = engine.GetDroppedBuyCount();
+  result.droppedSells = engine.GetDroppedSellCount();
+  return result;
+}
+
+} // namespace
+
+std::vector<StrategyParams> MakeSweepGrid(const std::vector<double> &edges,
+                                          const std::vector<int> &lots,
+                                          const std::vector<double> &stopLosses) {
+  std::vector<StrategyParams> grid;
+  grid.reserve(edges.size() * lots.size() * stopLosses.size());
+  for (double edge : edges) {
+    for (int lot : lots) {
+      for (double stopLoss : stopLosses) {
+        StrategyParams params{};
+        params.MinArbitrageEdge = edge;
+        params.MaxAbsExposureLots = lot;
+        params.StopLossPnl = stopLoss;
+        params.Validate();
+        grid.push_back(params);
+      }
+    }
+  }
+  return grid;
+}
+
+std::vector<SweepResult> RunSweep(const EventStore &store, size_t begin,
+                                  size_t end,
+                                  const std::vector<StrategyParams> &grid,
+                                  ThreadPool &pool, size_t lanes) {
+  lanes = std::max<size_t>(lanes, 1);
+
+  // One task per group of `lanes` consecutive parameter sets
+  std::vector<std::future<std::vector<SweepResult>>> pending;
+  pending.reserve((grid.size() + lanes - 1) / lanes);
+  for (size_t first = 0; first < grid.size(); first += lanes) {
+    const size_t last = std::min(first + lanes, grid.size());
+    std::vector<StrategyParams> group(grid.begin() + first,
+                                      grid.begin() + last);
+    pending.push_back(pool.Submit(
+        [&store, begin, end, lanes, group = std::move(group)]() {
+          if (lanes == 1) {
+            return std::vector<SweepResult>{
+                RunOne(store, begin, end, group.front())};
+          }
+          MultiConfigEngine engine(group);
+          engine.Run(store, begin, end);
+          return engine.Results();
+        }));
+  }
+
+  std::vector<SweepResult> results;
+  results.reserve(grid.size());
+  for (std::future<std::vector<SweepResult>> &f : pending) {
+    for (const SweepResult &r : f.get()) {
+      results.push_back(r);
+    }
+  }
+  return results;
+}
+
+void WriteSweepCsv(std::ostream &out, const std::vector<SweepResult> &results) {
+  out << "MinArbitrageEdge,MaxAbsExposureLots,StopLossPnl,Events,Stopped,"
+         "TotalPnl,BestPnl,WorstPnl,MaxExposure,TradedLots,DroppedBuys,"
+         "DroppedSells\n";
+  for (const SweepResult &r : results) {
+    out << r.params.MinArbitrageEdge << ',' << r.params.MaxAbsExposureLots
+        << ',' << r.params.StopLossPnl << ',' << r.events << ','
+        << (r.stopped ? 1 : 0) << ',' << r.totalPnl << ',' << r.bestPnl << ','
+        << r.worstPnl << ',' << r.maxExposure << ',' << r.tradedLots << ','
+        << r.droppedBuys << ',' << r.droppedSells << '\n';
+  }
+}
+
+} // namespace ArbSim
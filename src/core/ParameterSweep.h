@@ -0,0 +1,50 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "EventStore.h"
+#include "StrategyParams.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace ArbSim {
+
+// Outcome of one parameter set over the whole replay (PrintSummary fields)
+struct SweepResult {
+  StrategyParams params;
+  uint64_t events;
+  bool stopped;
+  double totalPnl;
+  double bestPnl;
+  double worstPnl;
+  int maxExposure;
+  int tradedLots;
+  size_t droppedBuys;
+  size_t droppedSells;
+};
+
+// Cartesian product, MinArbitrageEdge varying slowest. Every set is
+// validated (StrategyParams::Validate).
+std::vector<StrategyParams> MakeSweepGrid(const std::vector<double> &edges,
+                                          const std::vector<int> &lots,
+                                          const std::vector<double> &stopLosses);
+
+// Runs every parameter set over store events [begin, end) on the pool,
+// including the end-of-day close. With lanes == 1 each task is one
+// SimulationEngine; with lanes > 1 each task advances up to `lanes` sets in
+// lockstep in a MultiConfigEngine. The store is shared read-only; results
+// come back in grid order and do not depend on lanes.
+std::vector<SweepResult> RunSweep(const EventStore &store, size_t begin,
+                                  size_t end,
+                                  const std::vector<StrategyParams> &grid,
+                                  ThreadPool &pool, size_t lanes = 1);
+
+// One CSV row per result, with a header line
+void WriteSweepCsv(std::ostream &out, const std::vector<SweepResult> &results);
+
+} // namespace ArbSim
+
+#endif // PARAMETER_SWEEP_H
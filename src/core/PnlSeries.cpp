@@ -0,0 +1,158 @@
+#include "PnlSeries.h"
+
+#include "MarketData.h"
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace ArbSim {
+
+PnlSeries::PnlSeries(size_t reserveSamples) {
+  time_.reserve(reserveSamples);
+  pnlTicks_.reserve(reserveSamples);
+  midBTicks_.reserve(reserveSamples);
+  position_.reserve(reserveSamples);
+}
+
+size_t PnlSeries::Size() const { return time_.size(); }
+
+bool PnlSeries::Empty() const { return time_.empty(); }
+
+void PnlSeries::WriteFile(const std::string &filePath,
+                          PnlSeriesFormat format) const {
+  std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("PnlSeries: Failed to create file: " + filePath);
+  }
+  if (format == PnlSeriesFormat::Binary) {
+    WriteBinary(file);
+  } else {
+    WriteNdjson(file);
+  }
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("PnlSeries: Failed to write file: " + filePath);
+  }
+}
+
+void PnlSeries::WriteNdjson(std::ostream &out) const {
+  // Prices and PnL are the shortest text that reads back as the same double
+  OutputBuffer text;
+  for (size_t i = 0; i < Size(); ++i) {
+    text << "{\"time\":" << time_[i] << ",\"pnl\":";
+    text.AppendDouble(TicksToPrice(pnlTicks_[i]));
+    text << ",\"midB\":";
+    text.AppendDouble(TicksToPrice(midBTicks_[i]));
+    text << ",\"position\":" << position_[i] << "}\n";
+    if (text.View().size() >= kOutputBufferSize) {
+      out.write(text.View().data(),
+                static_cast<std::streamsize>(text.View().size()));
+      text.Clear();
+    }
+  }
+  out.write(text.View().data(),
+            static_cast<std::streamsize>(text.View().size()));
+}
+
+void PnlSeries::WriteBinary(std::ostream &out) const {
+  PnlSeriesHeader header{};
+  std::memcpy(header.magic, kPnlSeriesMagic, sizeof(header.magic));
+  header.version = kPnlSeriesVersion;
+  header.columnCount = kPnlSeriesColumns;
+  header.count = Size();
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  const std::streamsize bytes =
+      static_cast<std::streamsize>(Size() * sizeof(int64_t));
+  for (const std::vector<int64_t> *column :
+       {&time_, &pnlTicks_, &midBTicks_, &position_}) {
+    out.write(reinterpret_cast<const char *>(column->data()), bytes);
+  }
+}
+
+PnlSeries DownsamplePnlSeries(const PnlSeries &series, size_t maxPoints) {
+  if (maxPoints < kMinDownsamplePoints) {
+    throw std::runtime_error(
+        "DownsamplePnlSeries: maxPoints must be >= " +
+        std::to_string(kMinDownsamplePoints) + ", got " +
+        std::to_string(maxPoints));
+  }
+  const size_t n = series.Size();
+  PnlSeries out(std::min(n, maxPoints));
+  const auto keep = [&](size_t i) {
+    out.Record(series.Time()[i], series.PnlTicks()[i], series.MidBTicks()[i],
+               series.Position()[i]);
+  };
+  if (n <= maxPoints) {
+    for (size_t i = 0; i < n; ++i) {
+      keep(i);
+    }
+    return out;
+  }
+
+  // Buckets over the inner samples [1, n - 1)
+  const int64_t *pnl = series.PnlTicks();
+  const size_t inner = n - 2;
+  const size_t buckets = (maxPoints - 2) / 2;
+  keep(0);
+  for (size_t b = 0; b < buckets; ++b) {
+    const size_t begin = 1 + b * inner / buckets;
+    const size_t end = 1 + (b + 1) * inner / buckets;
+    size_t lo = begin;
+    size_t hi = begin;
+    for (size_t i = begin + 1; i < end; ++i) {
+      lo = pnl[i] < pnl[lo] ? i : lo;
+      hi = pnl[i] > pnl[hi] ? i : hi;
+    }
+    keep(std::min(lo, hi));
+    if (lo != hi) {
+      keep(std::max(lo, hi));
+    }
+  }
+  keep(n - 1);
+  return out;
+}
+
+PnlSeries ReadPnlSeriesFile(const std::string &filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("ReadPnlSeriesFile: Failed to open file: " +
+                             filePath);
+  }
+
+  PnlSeriesHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kPnlSeriesMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("ReadPnlSeriesFile: Not a PnL series: " +
+                             filePath);
+  }
+  if (header.version != kPnlSeriesVersion ||
+      header.columnCount != kPnlSeriesColumns) {
+    throw std::runtime_error("ReadPnlSeriesFile: Unsupported version " +
+                             std::to_string(header.version) + " in: " +
+                             filePath);
+  }
+
+  const size_t count = static_cast<size_t>(header.count);
+  std::vector<int64_t> columns[kPnlSeriesColumns];
+  for (std::vector<int64_t> &column : columns) {
+    column.resize(count);
+    if (count > 0 &&
+        !file.read(reinterpret_cast<char *>(column.data()),
+                   static_cast<std::streamsize>(count * sizeof(int64_t)))) {
+      throw std::runtime_error("ReadPnlSeriesFile: Truncated PnL series: " +
+                               filePath);
+    }
+  }
+
+  PnlSeries series(count);
+  for (size_t i = 0; i < count; ++i) {
+    series.Record(columns[0][i], columns[1][i], columns[2][i], columns[3][i]);
+  }
+  return series;
+}
+
+} // namespace ArbSim
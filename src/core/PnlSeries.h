@@ -0,0 +1,92 @@
+#ifndef PNL_SERIES_H
+#define PNL_SERIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+enum class PnlSeriesFormat {
+  Ndjson, // one {"time","pnl","midB","position"} object per line
+  Binary, // PnlSeriesHeader + int64 columns (ReadPnlSeriesFile)
+};
+
+// PnL time series recorded during the replay: one sample per row, stored as
+// int64 columns (time, total PnL ticks, mid B ticks, B position) reserved up
+// front, so Record() is a few stores and never does I/O. WriteFile() writes
+// the whole series once the loop is done.
+class PnlSeries {
+public:
+  // 36 hours at one sample per second (4MB); more samples grow the columns
+  static constexpr size_t kDefaultReserve = 1 << 17;
+
+  explicit PnlSeries(size_t reserveSamples = kDefaultReserve);
+
+  void Record(int64_t time, int64_t pnlTicks, int64_t midBTicks,
+              int64_t position) {
+    time_.push_back(time);
+    pnlTicks_.push_back(pnlTicks);
+    midBTicks_.push_back(midBTicks);
+    position_.push_back(position);
+  }
+
+  size_t Size() const;
+  bool Empty() const;
+
+  // Columns, Size() entries each
+  const int64_t *Time() const { return time_.data(); }
+  const int64_t *PnlTicks() const { return pnlTicks_.data(); }
+  const int64_t *MidBTicks() const { return midBTicks_.data(); }
+  const int64_t *Position() const { return position_.data(); }
+
+  // Writes the series to filePath; throws std::runtime_error on I/O errors
+  void WriteFile(const std::string &filePath, PnlSeriesFormat format) const;
+
+private:
+  std::vector<int64_t> time_;
+  std::vector<int64_t> pnlTicks_;
+  std::vector<int64_t> midBTicks_;
+  std::vector<int64_t> position_;
+
+  void WriteNdjson(std::ostream &out) const;
+  void WriteBinary(std::ostream &out) const;
+};
+
+// Smallest point budget DownsamplePnlSeries() accepts: first, last and one
+// low/high pair
+constexpr size_t kMinDownsamplePoints = 4;
+
+// Thins a series to at most maxPoints samples (maxPoints >= 4) for charting,
+// keeping its PnL extremes: the first and last samples stay, and the ones in
+// between are split into (maxPoints - 2) / 2 equal runs of which only the
+// lowest and highest PnL samples are kept, in time order. Kept samples are
+// whole rows of the input. One pass; a series that already fits is copied.
+PnlSeries DownsamplePnlSeries(const PnlSeries &series, size_t maxPoints);
+
+// Binary series file: one header, then the time, PnL, mid B and position
+// columns, `count` int64 values each, in host byte order (same conventions
+// as BinaryEventFile.h).
+constexpr char kPnlSeriesMagic[8] = {'A', 'R', 'B', 'S', 'I', 'M', 'P', 'S'};
+constexpr uint32_t kPnlSeriesVersion = 1;
+constexpr uint32_t kPnlSeriesColumns = 4;
+
+struct PnlSeriesHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t columnCount;
+  uint64_t count;
+  uint8_t reserved[8];
+};
+
+static_assert(sizeof(PnlSeriesHeader) == 32, "PnlSeriesHeader layout");
+
+// Reads a whole binary series file; throws std::runtime_error if the file is
+// not one or is truncated
+PnlSeries ReadPnlSeriesFile(const std::string &filePath);
+
+} // namespace ArbSim
+
+#endif // PNL_SERIES_H
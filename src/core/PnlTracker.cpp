@@ -33,6 +33,10 @@ double PnlTracker::GetLastMidB() const { return ToDouble(lastMidBInt_); }
 
 double PnlTracker::GetTotalPnl() const { return ToDouble(totalPnlInt_); }
 
+int64_t PnlTracker::GetLastMidBTicks() const { return lastMidBInt_; }
+
+int64_t PnlTracker::GetTotalPnlTicks() const { return totalPnlInt_; }
+
 double PnlTracker::GetBestPnl() const {
   return hasExtremes_ ? ToDouble(bestPnlInt_) : 0.0;
 }
@@ -48,21 +52,28 @@ int PnlTracker::GetTradedLots() const { return tradedLots_; }
 // --- Logic ---
 
 void PnlTracker::OnQuoteB(const MarketEvent &bEvent) {
-  // Calculate Mid in double, then convert to int
-  const double mid = (bEvent.bid + bEvent.ask) * 0.5;
-  lastMidBInt_ = ToInt(mid);
+  OnMidB(MidTicks(bEvent.bidTicks, bEvent.askTicks));
+}
+
+void PnlTracker::OnMidB(int64_t midTicks) {
+  lastMidBInt_ = midTicks;
   hasMidB_ = true;
 
   MarkToMarket();
 }
 
-void PnlTracker::ApplyTradeB(long long /*time*/, Side side, double price,
+void PnlTracker::ApplyTradeB(long long time, Side side, double price,
                              int quantity) {
+  ApplyTradeBTicks(time, side, ToInt(price), quantity);
+}
+
+void PnlTracker::ApplyTradeBTicks(long long /*time*/, Side side,
+                                  int64_t priceTicks, int quantity) {
   if (quantity <= 0) {
     return;
   }
 
-  const int64_t priceInt = ToInt(price);
+  const int64_t priceInt = priceTicks;
   const int64_t costInt = priceInt * quantity;
 
   if (side == Side::Buy) {
@@ -134,4 +145,32 @@ void PnlTracker::FlattenAtMid(long long /*time*/) {
   MarkToMarket();
 }
 
+PnlTrackerState PnlTracker::SaveState() const {
+  PnlTrackerState state{};
+  state.cash = cashInt_;
+  state.lastMidB = lastMidBInt_;
+  state.totalPnl = totalPnlInt_;
+  state.bestPnl = bestPnlInt_;
+  state.worstPnl = worstPnlInt_;
+  state.positionB = positionB_;
+  state.maxAbsExposure = maxAbsExposure_;
+  state.tradedLots = tradedLots_;
+  state.hasMidB = hasMidB_ ? 1 : 0;
+  state.hasExtremes = hasExtremes_ ? 1 : 0;
+  return state;
+}
+
+void PnlTracker::RestoreState(const PnlTrackerState &state) {
+  cashInt_ = state.cash;
+  lastMidBInt_ = state.lastMidB;
+  totalPnlInt_ = state.totalPnl;
+  bestPnlInt_ = state.bestPnl;
+  worstPnlInt_ = state.worstPnl;
+  positionB_ = state.positionB;
+  maxAbsExposure_ = state.maxAbsExposure;
+  tradedLots_ = state.tradedLots;
+  hasMidB_ = state.hasMidB != 0;
+  hasExtremes_ = state.hasExtremes != 0;
+}
+
 } // namespace ArbSim
\ No newline at end of file
@@ -9,6 +9,24 @@
 namespace ArbSim
 {
 
+    // Everything a PnlTracker holds, as saved in checkpoints (Checkpoint.h)
+    struct PnlTrackerState
+    {
+        int64_t cash;
+        int64_t lastMidB;
+        int64_t totalPnl;
+        int64_t bestPnl;
+        int64_t worstPnl;
+        int32_t positionB;
+        int32_t maxAbsExposure;
+        int32_t tradedLots;
+        uint8_t hasMidB;
+        uint8_t hasExtremes;
+        uint8_t reserved[2];
+    };
+
+    static_assert(sizeof(PnlTrackerState) == 56, "PnlTrackerState layout");
+
     class PnlTracker
     {
     public:
@@ -20,17 +38,35 @@ namespace ArbSim
         bool HasMidB() const;
         double GetLastMidB() const;
         double GetTotalPnl() const;
+        // Same values in ticks of 1 / kPnlMultiplier, with no conversion
+        int64_t GetLastMidBTicks() const;
+        int64_t GetTotalPnlTicks() const;
         double GetBestPnl() const;
         double GetWorstPnl() const;
         int GetMaxAbsExposure() const;
         int GetTradedLots() const;
 
         void OnQuoteB(const MarketEvent& bEvent);
+        // Same, with the mid already computed by MidTicks()
+        void OnMidB(int64_t midTicks);
+
+        // Mid of a quote in ticks; a half-tick rounds away from zero, like
+        // rounding the double mid would
+        static int64_t MidTicks(int64_t bidTicks, int64_t askTicks)
+        {
+            const int64_t sum = bidTicks + askTicks;
+            return (sum + (sum >= 0 ? 1 : -1)) / 2;
+        }
         void ApplyTradeB(long long time, Side side, double price, int quantity);
+        // Same, with the price already in ticks (MarketEvent::bidTicks/askTicks)
+        void ApplyTradeBTicks(long long time, Side side, int64_t priceTicks, int quantity);
         
         // Helper to force a flatten (used by Stop Loss)
         void FlattenAtMid(long long time);
 
+        PnlTrackerState SaveState() const;
+        void RestoreState(const PnlTrackerState& state);
+
     private:
         // Precision Multiplier (6 decimal places)
         static constexpr int64_t Multiplier = kPnlMultiplier;
@@ -0,0 +1,177 @@
+#include "PrefetchingEventSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+
+namespace ArbSim {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t ElapsedNs(Clock::time_point since) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           since)
+          .count());
+}
+
+} // namespace
+
+PrefetchingEventSource::PrefetchingEventSource(
+    std::unique_ptr<IEventSource> inner, size_t batchEvents,
+    size_t ringBatches)
+    : inner_(std::move(inner)), batchEvents_(batchEvents > 0 ? batchEvents : 1),
+      ring_(ringBatches), current_(nullptr), pos_(0), finished_(false),
+      producerDone_(false), stop_(false), fullStalls_(0), fullStallNs_(0),
+      emptyStalls_(0), emptyStallNs_(0) {
+  producer_ = std::thread(&PrefetchingEventSource::ProducerLoop, this);
+}
+
+PrefetchingEventSource::~PrefetchingEventSource() {
+  stop_.store(true, std::memory_order_relaxed);
+  if (producer_.joinable()) {
+    producer_.join();
+  }
+}
+
+const std::string &PrefetchingEventSource::GetFilePath() const {
+  return inner_->GetFilePath();
+}
+
+void PrefetchingEventSource::ProducerLoop() {
+  bool more = true;
+  while (more) {
+    Batch *slot = ring_.BeginPush();
+    if (slot == nullptr) {
+      fullStalls_.fetch_add(1, std::memory_order_relaxed);
+      const auto t0 = Clock::now();
+      while ((slot = ring_.BeginPush()) == nullptr) {
+        if (stop_.load(std::memory_order_relaxed)) {
+          return;
+        }
+        std::this_thread::yield();
+      }
+      fullStallNs_.fetch_add(ElapsedNs(t0), std::memory_order_relaxed);
+    }
+
+    size_t n = 0;
+    try {
+      if (slot->events.size() < batchEvents_) {
+        slot->events.resize(batchEvents_);
+      }
+      // Whole blocks per virtual call; only 0 means end of stream
+      while (n < batchEvents_) {
+        const size_t got =
+            inner_->ReadEvents(slot->events.data() + n, batchEvents_ - n);
+        if (got == 0) {
+          more = false;
+          break;
+        }
+        n += got;
+      }
+    } catch (...) {
+      // Published before producerDone_ (release), read after it (acquire)
+      error_ = std::current_exception();
+      more = false;
+    }
+
+    // Events parsed before an error are still delivered
+    slot->count = n;
+    if (n > 0) {
+      ring_.CommitPush();
+    }
+
+    if (stop_.load(std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  producerDone_.store(true, std::memory_order_release);
+}
+
+bool PrefetchingEventSource::AcquireNextBatch() {
+  if (current_ != nullptr) {
+    ring_.Pop();
+    current_ = nullptr;
+  }
+
+  Batch *front = ring_.Front();
+  if (front == nullptr) {
+    ++emptyStalls_;
+    const auto t0 = Clock::now();
+    while ((front = ring_.Front()) == nullptr) {
+      if (producerDone_.load(std::memory_order_acquire)) {
+        // The producer may have published its last batch just before
+        // finishing; look once more before giving up.
+        front = ring_.Front();
+        break;
+      }
+      std::this_thread::yield();
+    }
+    emptyStallNs_ += ElapsedNs(t0);
+  }
+
+  if (front == nullptr) {
+    finished_ = true;
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return false;
+  }
+
+  current_ = front;
+  pos_ = 0;
+  return true;
+}
+
+bool PrefetchingEventSource::ReadNextEvent(MarketEvent &event) {
+  if (finished_) {
+    return false;
+  }
+
+  if (current_ == nullptr || pos_ == current_->count) {
+    if (!AcquireNextBatch()) {
+      return false;
+    }
+  }
+
+  event = current_->events[pos_++];
+  return true;
+}
+
+size_t PrefetchingEventSource::ReadEvents(MarketEvent *out, size_t max) {
+  if (finished_) {
+    return 0;
+  }
+
+  // At most the rest of one batch per call, so a producer error is only
+  // rethrown by a call that has nothing else to return
+  if (current_ == nullptr || pos_ == current_->count) {
+    if (!AcquireNextBatch()) {
+      return 0;
+    }
+  }
+
+  const size_t take = std::min(max, current_->count - pos_);
+  std::copy_n(current_->events.data() + pos_, take, out);
+  pos_ += take;
+  return take;
+}
+
+uint64_t PrefetchingEventSource::GetFullStalls() const {
+  return fullStalls_.load(std::memory_order_relaxed);
+}
+
+uint64_t PrefetchingEventSource::GetEmptyStalls() const { return emptyStalls_; }
+
+void PrefetchingEventSource::PrintStats(std::ostream &out) const {
+  out << "Prefetch " << GetFilePath() << ": ring full stalls "
+      << GetFullStalls() << " ("
+      << fullStallNs_.load(std::memory_order_relaxed) / 1e6
+      << " ms), ring empty stalls " << emptyStalls_ << " ("
+      << emptyStallNs_ / 1e6 << " ms)\n";
+  inner_->PrintStats(out);
+}
+
+} // namespace ArbSim
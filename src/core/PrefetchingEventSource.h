@@ -0,0 +1,82 @@
+#ifndef PREFETCHING_EVENT_SOURCE_H
+#define PREFETCHING_EVENT_SOURCE_H
+
+#include "IEventSource.h"
+#include "MarketData.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ArbSim {
+
+// Drives another event source from a dedicated producer thread, which
+// parses ahead into a bounded SPSC ring of event batches. The simulation
+// thread only pulls already-parsed events.
+//
+// Stall counters tell which side is the bottleneck:
+//  - full stalls:  producer waited for a free slot (consumer is slower)
+//  - empty stalls: consumer waited for a batch (parsing/I/O is slower)
+//
+// Errors thrown by the inner source are rethrown from ReadNextEvent() after
+// every event parsed before the error has been delivered.
+class PrefetchingEventSource : public IEventSource {
+public:
+  static constexpr size_t kDefaultBatchEvents = 4096;
+  static constexpr size_t kDefaultRingBatches = 8;
+
+  explicit PrefetchingEventSource(std::unique_ptr<IEventSource> inner,
+                                  size_t batchEvents = kDefaultBatchEvents,
+                                  size_t ringBatches = kDefaultRingBatches);
+  ~PrefetchingEventSource() override;
+
+  PrefetchingEventSource(const PrefetchingEventSource &) = delete;
+  PrefetchingEventSource &operator=(const PrefetchingEventSource &) = delete;
+
+  const std::string &GetFilePath() const override;
+  bool ReadNextEvent(MarketEvent &event) override;
+  size_t ReadEvents(MarketEvent *out, size_t max) override;
+  void PrintStats(std::ostream &out) const override;
+
+  uint64_t GetFullStalls() const;
+  uint64_t GetEmptyStalls() const;
+
+private:
+  struct Batch {
+    std::vector<MarketEvent> events;
+    size_t count = 0;
+  };
+
+  std::unique_ptr<IEventSource> inner_;
+  const size_t batchEvents_;
+  SpscRing<Batch> ring_;
+
+  // Consumer position inside ring_.Front()
+  Batch *current_;
+  size_t pos_;
+  bool finished_;
+
+  std::atomic<bool> producerDone_;
+  std::atomic<bool> stop_;
+  std::exception_ptr error_;
+
+  // Producer-side counters (written by the producer thread only)
+  std::atomic<uint64_t> fullStalls_;
+  std::atomic<uint64_t> fullStallNs_;
+  // Consumer-side counters
+  uint64_t emptyStalls_;
+  uint64_t emptyStallNs_;
+
+  std::thread producer_;
+
+  void ProducerLoop();
+  bool AcquireNextBatch();
+};
+
+} // namespace ArbSim
+
+#endif // PREFETCHING_EVENT_SOURCE_H
@@ -0,0 +1,169 @@
+#ifndef PRICE_PARSER_H
+#define PRICE_PARSER_H
+
+#include "Constants.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace ArbSim {
+
+// Locale-free decimal price parser.
+//
+// Plain decimals ("-10928.25") are converted straight from the digits:
+//  - scaled = price * kPnlMultiplier as int64, equal to
+//    std::llround(std::strtod(s) * kPnlMultiplier) (PnlTracker::ToInt)
+//  - value  = the correctly rounded double, equal to std::strtod(s)
+// Anything outside the exact fast path (more than kPnlDecimals fraction
+// digits, 16+ significant digits, scaled value of 2^51 or more, exponents,
+// inf/nan) falls back to
+// std::from_chars and derives scaled from the double, so results stay
+// bit-exact with the strtod path in every case.
+//
+// Parses from begin, never reads at or past end. Returns the first
+// unconsumed character, or nullptr if no number was found.
+
+namespace PriceParserDetail {
+
+constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                             1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                             1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+constexpr int64_t kIntPow10[] = {1,       10,       100,       1000,
+                                 10000,   100000,   1000000,   10000000,
+                                 100000000};
+
+static_assert(kPnlDecimals <= 8 && kIntPow10[kPnlDecimals] == kPnlMultiplier,
+              "kPnlDecimals must match kPnlMultiplier");
+
+// Fast-path bound on the scaled value: below 2^51 the double product
+// value * kPnlMultiplier is within 0.5 of the exact integer, so llround on
+// the strtod path lands on the same result as the integer arithmetic.
+constexpr uint64_t kMaxFastScaled = (1ULL << 51) - 1;
+
+struct Decimal {
+  uint64_t mantissa;
+  int fractionDigits;
+  bool negative;
+  const char *next;
+};
+
+// Scans [+-]digits[.digits]. Returns false if this is not a plain decimal
+// the fast path can take exactly.
+inline bool ScanPlainDecimal(const char *p, const char *end, Decimal &out) {
+  out.negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    out.negative = (*p == '-');
+    ++p;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int fraction = 0;
+  bool any = false;
+
+  while (p < end && static_cast<unsigned>(*p - '0') <= 9) {
+    mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+    digits += (mantissa != 0);
+    any = true;
+    ++p;
+  }
+
+  if (p < end && *p == '.') {
+    ++p;
+    while (p < end && static_cast<unsigned>(*p - '0') <= 9) {
+      mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+      digits += (mantissa != 0);
+      ++fraction;
+      any = true;
+      ++p;
+    }
+  }
+
+  if (!any || digits > 15 || fraction > kPnlDecimals) {
+    return false;
+  }
+  // Exponent: leave to the general parser
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    return false;
+  }
+
+  out.mantissa = mantissa;
+  out.fractionDigits = fraction;
+  out.next = p;
+  return mantissa <= kMaxFastScaled / kIntPow10[kPnlDecimals - fraction];
+}
+
+inline const char *ParseSlow(const char *begin, const char *end,
+                             double &value) {
+  const char *p = begin;
+  // from_chars rejects a leading '+', strtod accepts it
+  if (p < end && *p == '+') {
+    ++p;
+  }
+  const auto res = std::from_chars(p, end, value);
+  return res.ec == std::errc() ? res.ptr : nullptr;
+}
+
+} // namespace PriceParserDetail
+
+inline const char *ParsePrice(const char *begin, const char *end,
+                              double &value) {
+  using namespace PriceParserDetail;
+  Decimal d;
+  if (ScanPlainDecimal(begin, end, d)) {
+    // Both operands exact, one IEEE division: correctly rounded (Clinger)
+    const double v =
+        static_cast<double>(d.mantissa) / kPow10[d.fractionDigits];
+    value = d.negative ? -v : v;
+    return d.next;
+  }
+  return ParseSlow(begin, end, value);
+}
+
+inline const char *ParsePrice(const char *begin, const char *end,
+                              int64_t &scaled, double &value) {
+  using namespace PriceParserDetail;
+  Decimal d;
+  if (ScanPlainDecimal(begin, end, d)) {
+    const double v =
+        static_cast<double>(d.mantissa) / kPow10[d.fractionDigits];
+    const int64_t s = static_cast<int64_t>(d.mantissa) *
+                      kIntPow10[kPnlDecimals - d.fractionDigits];
+    value = d.negative ? -v : v;
+    scaled = d.negative ? -s : s;
+    return d.next;
+  }
+
+  const char *next = ParseSlow(begin, end, value);
+  if (next != nullptr) {
+    scaled = std::llround(value * static_cast<double>(kPnlMultiplier));
+  }
+  return next;
+}
+
+// Scaled value only (MarketEvent ticks); skips the double division on the
+// fast path.
+inline const char *ParsePriceTicks(const char *begin, const char *end,
+                                   int64_t &scaled) {
+  using namespace PriceParserDetail;
+  Decimal d;
+  if (ScanPlainDecimal(begin, end, d)) {
+    const int64_t s = static_cast<int64_t>(d.mantissa) *
+                      kIntPow10[kPnlDecimals - d.fractionDigits];
+    scaled = d.negative ? -s : s;
+    return d.next;
+  }
+
+  double value;
+  const char *next = ParseSlow(begin, end, value);
+  if (next != nullptr) {
+    scaled = std::llround(value * static_cast<double>(kPnlMultiplier));
+  }
+  return next;
+}
+
+} // namespace ArbSim
+
+#endif // PRICE_PARSER_H
@@ -1,39 +1,79 @@
 #ifndef SIMULATION_ENGINE_H
 #define SIMULATION_ENGINE_H
 
-#include <iosfwd>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
 #include <string>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
+#include "Checkpoint.h"
+#include "EventStore.h"
+#include "Istrategy.h"
 #include "MarketData.h"
+#include "OutputBuffer.h"
 #include "PnlTracker.h"
 #include "Strategy.h"
+#include "TradeLog.h"
 
 namespace ArbSim {
 
+// The engine is a template over its strategy policy (see IsStrategyPolicy in
+// Istrategy.h): StrategyT is stored by value and its Decide() is called
+// directly, so a new strategy costs no per-event dispatch and no engine
+// change. SimulationEngine<Strategy> is compiled once in SimulationEngine.cpp;
+// the argument is deduced from the constructor:
+//   SimulationEngine engine(Strategy(params), PnlTracker(), tradeLog);
+template <typename StrategyT = Strategy>
 class SimulationEngine {
+    static_assert(IsStrategyPolicy<StrategyT>::value,
+                  "SimulationEngine: StrategyT must provide Decide() or DecideTicks() (see Istrategy.h)");
+
 public:
-    SimulationEngine(Strategy strategy, PnlTracker pnl, std::string& tradeLogBuffer);
+    // Fills are appended to tradeLogBuffer as text lines
+    SimulationEngine(StrategyT strategy, PnlTracker pnl, std::string& tradeLogBuffer);
+    // Fills go to the sink as TradeRecords (e.g. AsyncTradeWriter); the sink
+    // must outlive the engine
+    SimulationEngine(StrategyT strategy, PnlTracker pnl, ITradeSink& tradeSink);
 
     void OnEvent(const MarketEvent& ev);
+    // Processes events in order until the engine stops; returns how many
+    // were consumed (including the one that triggered the stop)
+    size_t OnEvents(const MarketEvent* events, size_t count);
+    // Same as OnEvents() over store events [begin, end), reassembled one at
+    // a time. Can be mixed with OnEvent().
+    size_t OnEvents(const EventStore& store, size_t begin, size_t end);
     void OnEndOfDay(long long time);
+    void PrintSummary(OutputBuffer& out) const;
     void PrintSummary(std::ostream& out) const;
 
+    // Checkpoint support: the whole engine state except the strategy and
+    // the trade sink. Restoring continues the trade sequence.
+    EngineState SaveState() const;
+    void RestoreState(const EngineState& state);
+
     // Getters for Main loop logging
-    double GetTotalPnl() const;
-    double GetLastMidB() const;
-    double GetLastMidA() const;
-    bool IsStopped() const;
+    double GetTotalPnl() const { return pnl_.GetTotalPnl(); }
+    double GetLastMidB() const { return pnl_.GetLastMidB(); }
+    double GetLastMidA() const { return 0.0; }
+    bool IsStopped() const { return stopTrading_; }
+    const PnlTracker& GetPnl() const { return pnl_; }
+    const StrategyT& GetStrategy() const { return strategy_; }
 
     // Observability: expose dropped trade counts
-    size_t GetDroppedBuyCount() const;
-    size_t GetDroppedSellCount() const;
-    size_t GetTotalDroppedTrades() const;
+    size_t GetDroppedBuyCount() const { return droppedBuyCount_; }
+    size_t GetDroppedSellCount() const { return droppedSellCount_; }
+    size_t GetTotalDroppedTrades() const { return droppedBuyCount_ + droppedSellCount_; }
 
 private:
-    Strategy strategy_;
+    StrategyT strategy_;
     PnlTracker pnl_;
-    std::string& tradeLog_;
+    std::unique_ptr<StringTradeSink> ownedSink_; // for the string constructor
+    ITradeSink* tradeSink_;
+    uint64_t tradeSequence_;
 
     MarketEvent lastQuoteA_;
     MarketEvent lastQuoteB_;
@@ -45,12 +85,226 @@ private:
     size_t droppedBuyCount_;
     size_t droppedSellCount_;
 
+    SimulationEngine(StrategyT strategy, PnlTracker pnl, std::unique_ptr<StringTradeSink> ownedSink);
+
     void TryTrade(long long time);
-    void ClosePositionAtMidAsTrade(long long time, const char* reasonTag);
-    void LogTrade(long long time, const char* side, double price);
-    void AppendLogLine(const char* line);
+    StrategyAction Decide(int64_t sellEdgeTicks, int64_t buyEdgeTicks) const;
+    void Execute(long long time, StrategyAction action);
+    void ClosePositionAtMidAsTrade(long long time, TradeReason reason);
+    void RecordTrade(long long time, Side side, int64_t priceTicks, int quantity, TradeReason reason);
 };
 
+template <typename StrategyT>
+SimulationEngine<StrategyT>::SimulationEngine(StrategyT strategy, PnlTracker pnl,
+                                              std::string& tradeLogBuffer)
+    : SimulationEngine(std::move(strategy), std::move(pnl), std::make_unique<StringTradeSink>(tradeLogBuffer)) {}
+
+template <typename StrategyT>
+SimulationEngine<StrategyT>::SimulationEngine(StrategyT strategy, PnlTracker pnl,
+                                              ITradeSink& tradeSink)
+    : SimulationEngine(std::move(strategy), std::move(pnl), std::unique_ptr<StringTradeSink>()) {
+    tradeSink_ = &tradeSink;
+}
+
+template <typename StrategyT>
+SimulationEngine<StrategyT>::SimulationEngine(StrategyT strategy, PnlTracker pnl,
+                                              std::unique_ptr<StringTradeSink> ownedSink)
+    : strategy_(std::move(strategy)),
+      pnl_(std::move(pnl)),
+      ownedSink_(std::move(ownedSink)),
+      tradeSink_(ownedSink_.get()),
+      tradeSequence_(0),
+      lastQuoteA_{},
+      lastQuoteB_{},
+      stopTrading_(false),
+      hasA_(false),
+      hasB_(false),
+      droppedBuyCount_(0),
+      droppedSellCount_(0) {}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::OnEvent(const MarketEvent& ev) {
+    if (ev.instrumentId == InstrumentId::FutureA) {
+        lastQuoteA_ = ev;
+        hasA_ = true;
+    } else if (ev.instrumentId == InstrumentId::FutureB) {
+        lastQuoteB_ = ev;
+        hasB_ = true;
+        pnl_.OnQuoteB(ev);
+    }
+
+    if (!hasA_ || !hasB_) {
+        return;
+    }
+
+    TryTrade(ev.sendingTime);
+}
+
+template <typename StrategyT>
+size_t SimulationEngine<StrategyT>::OnEvents(const MarketEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        OnEvent(events[i]);
+        if (stopTrading_) {
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+template <typename StrategyT>
+size_t SimulationEngine<StrategyT>::OnEvents(const EventStore& store, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        OnEvent(store.Get(i));
+        if (stopTrading_) {
+            return i + 1 - begin;
+        }
+    }
+    return end > begin ? end - begin : 0;
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::OnEndOfDay(long long time) {
+    if (!stopTrading_) {
+        ClosePositionAtMidAsTrade(time, TradeReason::EndOfDay);
+    }
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::PrintSummary(OutputBuffer& out) const {
+    out << "Simulation finished\n";
+    out << "Total PnL: " << pnl_.GetTotalPnl() << "\n";
+    out << "Best PnL: " << pnl_.GetBestPnl() << "\n";
+    out << "Worst PnL: " << pnl_.GetWorstPnl() << "\n";
+    out << "Max exposure: " << pnl_.GetMaxAbsExposure() << "\n";
+    out << "Traded lots: " << pnl_.GetTradedLots() << "\n";
+    out << "Dropped buys: " << droppedBuyCount_ << "\n";
+    out << "Dropped sells: " << droppedSellCount_ << "\n";
+    out << "Trade log peak memory: " << tradeSink_->GetPeakMemoryBytes() << " bytes\n";
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::PrintSummary(std::ostream& out) const {
+    OutputBuffer text;
+    PrintSummary(text);
+    out.write(text.View().data(), static_cast<std::streamsize>(text.View().size()));
+}
+
+template <typename StrategyT>
+EngineState SimulationEngine<StrategyT>::SaveState() const {
+    EngineState state{};
+    state.pnl = pnl_.SaveState();
+    state.lastQuoteA = lastQuoteA_;
+    state.lastQuoteB = lastQuoteB_;
+    state.tradeSequence = tradeSequence_;
+    state.droppedBuys = droppedBuyCount_;
+    state.droppedSells = droppedSellCount_;
+    state.hasA = hasA_ ? 1 : 0;
+    state.hasB = hasB_ ? 1 : 0;
+    state.stopped = stopTrading_ ? 1 : 0;
+    return state;
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::RestoreState(const EngineState& state) {
+    pnl_.RestoreState(state.pnl);
+    lastQuoteA_ = state.lastQuoteA;
+    lastQuoteB_ = state.lastQuoteB;
+    tradeSequence_ = state.tradeSequence;
+    droppedBuyCount_ = static_cast<size_t>(state.droppedBuys);
+    droppedSellCount_ = static_cast<size_t>(state.droppedSells);
+    hasA_ = state.hasA != 0;
+    hasB_ = state.hasB != 0;
+    stopTrading_ = state.stopped != 0;
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::TryTrade(long long time) {
+    if (stopTrading_) {
+        return;
+    }
+
+    const StrategyAction action = Decide(lastQuoteB_.bidTicks - lastQuoteA_.askTicks,
+                                         lastQuoteA_.bidTicks - lastQuoteB_.askTicks);
+    Execute(time, action);
+}
+
+template <typename StrategyT>
+StrategyAction SimulationEngine<StrategyT>::Decide(int64_t sellEdgeTicks, int64_t buyEdgeTicks) const {
+    // A direct call: StrategyT is the concrete policy. Tick policies get the
+    // exact edges and PnL; price policies get them converted to doubles
+    if constexpr (IsTickStrategyPolicy<StrategyT>::value) {
+        return strategy_.DecideTicks(sellEdgeTicks, buyEdgeTicks, pnl_.GetPositionB(), pnl_.GetTotalPnlTicks());
+    } else {
+        return strategy_.Decide(TicksToPrice(sellEdgeTicks), TicksToPrice(buyEdgeTicks),
+                                pnl_.GetPositionB(), pnl_.GetTotalPnl());
+    }
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::Execute(long long time, StrategyAction action) {
+    switch (action) {
+    case StrategyAction::Flatten:
+        ClosePositionAtMidAsTrade(time, TradeReason::StopLoss);
+        stopTrading_ = true;
+        break;
+
+    case StrategyAction::BuyB:
+        if (lastQuoteB_.askSize < 1) {
+            ++droppedBuyCount_;
+            return;
+        }
+        pnl_.ApplyTradeBTicks(time, Side::Buy, lastQuoteB_.askTicks, 1);
+        RecordTrade(time, Side::Buy, lastQuoteB_.askTicks, 1, TradeReason::Signal);
+        break;
+
+    case StrategyAction::SellB:
+        if (lastQuoteB_.bidSize < 1) {
+            ++droppedSellCount_;
+            return;
+        }
+        pnl_.ApplyTradeBTicks(time, Side::Sell, lastQuoteB_.bidTicks, 1);
+        RecordTrade(time, Side::Sell, lastQuoteB_.bidTicks, 1, TradeReason::Signal);
+        break;
+
+    case StrategyAction::None:
+    default:
+        break;
+    }
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::ClosePositionAtMidAsTrade(long long time, TradeReason reason) {
+    const int pos = pnl_.GetPositionB();
+    if (pos == 0 || !pnl_.HasMidB()) {
+        return;
+    }
+
+    const int64_t midTicks = pnl_.GetLastMidBTicks();
+    const int qty = std::abs(pos);
+    const Side side = (pos > 0) ? Side::Sell : Side::Buy;
+
+    pnl_.ApplyTradeBTicks(time, side, midTicks, qty);
+    RecordTrade(time, side, midTicks, qty, reason);
+}
+
+template <typename StrategyT>
+void SimulationEngine<StrategyT>::RecordTrade(long long time, Side side, int64_t priceTicks,
+                                              int quantity, TradeReason reason) {
+    // 32 bytes to the sink; formatting (if any) is the sink's job
+    TradeRecord trade{};
+    trade.time = time;
+    trade.priceTicks = priceTicks;
+    trade.sequence = tradeSequence_++;
+    trade.quantity = quantity;
+    trade.side = static_cast<uint8_t>(side);
+    trade.instrument = static_cast<uint8_t>(InstrumentId::FutureB);
+    trade.reason = reason;
+    tradeSink_->OnTrade(trade);
+}
+
+// The default policy is instantiated in SimulationEngine.cpp
+extern template class SimulationEngine<Strategy>;
+
 } // namespace ArbSim
 
 #endif // SIMULATION_ENGINE_H
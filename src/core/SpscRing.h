@@ -0,0 +1,74 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ArbSim {
+
+// Bounded lock-free single-producer / single-consumer ring.
+//
+// Slots are preallocated and filled in place: the producer gets the free
+// slot with BeginPush(), writes into it and publishes it with CommitPush();
+// the consumer reads Front() and releases it with Pop(). Nothing is
+// allocated or copied through the ring itself.
+template <typename T> class SpscRing {
+public:
+  explicit SpscRing(size_t capacity) : slots_(capacity), head_(0), tail_(0) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("SpscRing: capacity must be a power of two");
+    }
+  }
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  size_t Capacity() const { return slots_.size(); }
+
+  // --- Producer side ---
+
+  // Slot to fill next, or nullptr if the ring is full
+  T *BeginPush() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+      return nullptr;
+    }
+    return &slots_[tail & (slots_.size() - 1)];
+  }
+
+  void CommitPush() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // --- Consumer side ---
+
+  // Oldest published slot, or nullptr if the ring is empty
+  T *Front() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[head & (slots_.size() - 1)];
+  }
+
+  void Pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+private:
+  static constexpr size_t kCacheLine = 64;
+
+  std::vector<T> slots_;
+
+  // Separate cache lines so producer and consumer don't false-share
+  alignas(kCacheLine) std::atomic<size_t> head_;
+  alignas(kCacheLine) std::atomic<size_t> tail_;
+};
+
+} // namespace ArbSim
+
+#endif // SPSC_RING_H
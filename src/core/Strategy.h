@@ -2,12 +2,15 @@
 #define STRATEGY_H
 
 #include "../config/Config.h" // Include the Config definition
-#include "IStrategy.h"
+#include "Istrategy.h"
 #include "StrategyParams.h"
 
 namespace ArbSim {
 
-class Strategy : public IStrategy {
+// The default SimulationEngine policy: threshold arbitrage on the A/B edges
+// with an exposure limit and a stop loss. final, so calls on a Strategy are
+// never virtual.
+class Strategy final : public IStrategy {
 public:
   // Option 1: Initialize from a raw struct (Best for Unit Tests)
   explicit Strategy(const StrategyParams &params);
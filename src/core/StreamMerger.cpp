@@ -1,88 +1,75 @@
 #include "StreamMerger.h"
 
+#include <algorithm>
+
 namespace ArbSim {
 
-StreamMerger::StreamMerger(CsvReader &readerA, CsvReader &readerB,
+StreamMerger::StreamMerger(IEventSource &readerA, IEventSource &readerB,
                            unsigned int seed)
-    : readerA_(readerA), readerB_(readerB), hasNextA_(false), hasNextB_(false),
-      rng_(seed) // Initialize with fixed seed
-      ,
-      coinFlip_(0, 1) // Define range [0, 1]
-{}
-
-void StreamMerger::LoadNextAIfNeeded() {
-  if (hasNextA_) {
-    return;
-  }
+    : a_(readerA, kInputBlockEvents), b_(readerB, kInputBlockEvents),
+      startTime_(std::numeric_limits<long long>::min()),
+      endTime_(std::numeric_limits<long long>::max()),
+      tieBreaker_(seed) {}
 
-  MarketEvent ev{};
-  if (readerA_.ReadNextEvent(ev)) {
-    nextA_ = ev;
-    hasNextA_ = true;
-  } else {
-    hasNextA_ = false;
-  }
+void StreamMerger::SetTimeWindow(long long startTime, long long endTime) {
+  startTime_ = startTime;
+  endTime_ = endTime;
 }
 
-void StreamMerger::LoadNextBIfNeeded() {
-  if (hasNextB_) {
-    return;
-  }
-
-  MarketEvent ev{};
-  if (readerB_.ReadNextEvent(ev)) {
-    nextB_ = ev;
-    hasNextB_ = true;
-  } else {
-    hasNextB_ = false;
-  }
+// Only used once the other input is exhausted: no tie can follow, so the
+// run bookkeeping behind HeadOrdinal() is not kept up to date here.
+size_t StreamMerger::CopyRun(BufferedInput &input, MarketEvent *out, size_t max) {
+  const size_t take = std::min(max, input.count - input.pos);
+  std::copy_n(input.events.data() + input.pos, take, out);
+  input.pos += take;
+  return take;
 }
 
-bool StreamMerger::ReadNext(MarketEvent &outEvent) {
-  LoadNextAIfNeeded();
-  LoadNextBIfNeeded();
+size_t StreamMerger::ReadBatch(MarketEvent *out, size_t max) {
+  size_t n = 0;
+  while (n < max) {
+    const bool hasA = a_.HasEvent() || a_.Refill(startTime_, endTime_);
+    const bool hasB = b_.HasEvent() || b_.Refill(startTime_, endTime_);
 
-  if (!hasNextA_ && !hasNextB_) {
-    return false;
-  }
+    if (!hasA && !hasB) {
+      break;
+    }
 
-  // Case: Only A has data
-  if (hasNextA_ && !hasNextB_) {
-    outEvent = nextA_;
-    hasNextA_ = false;
-    return true;
-  }
+    // Case: Only one input has data
+    if (!hasB) {
+      n += CopyRun(a_, out + n, max - n);
+      continue;
+    }
+    if (!hasA) {
+      n += CopyRun(b_, out + n, max - n);
+      continue;
+    }
 
-  // Case: Only B has data
-  if (!hasNextA_ && hasNextB_) {
-    outEvent = nextB_;
-    hasNextB_ = false;
-    return true;
-  }
+    // Case: Both have data - merge until one block runs out
+    while (n < max && a_.pos < a_.count && b_.pos < b_.count) {
+      const MarketEvent &nextA = a_.events[a_.pos];
+      const MarketEvent &nextB = b_.events[b_.pos];
 
-  // Case: Both have data - Tie Breaking Logic
-  bool pickA = false;
+      bool pickA = false;
+      if (nextA.sendingTime < nextB.sendingTime) {
+        pickA = true;
+      } else if (nextA.sendingTime > nextB.sendingTime) {
+        pickA = false;
+      } else {
+        // Timestamps are equal!
+        // Per-event hash of (seed, timestamp, source, source ordinal) decides.
+        pickA = tieBreaker_.PickFirst(nextA.sendingTime, 0, a_.HeadOrdinal(),
+                                      1, b_.HeadOrdinal());
+      }
 
-  if (nextA_.sendingTime < nextB_.sendingTime) {
-    pickA = true;
-  } else if (nextA_.sendingTime > nextB_.sendingTime) {
-    pickA = false;
-  } else {
-    // Timestamps are equal!
-    // Use the deterministic RNG to decide.
-    // 1 = Pick A, 0 = Pick B
-    pickA = (coinFlip_(rng_) == 1);
+      out[n++] = pickA ? a_.Take() : b_.Take();
+    }
   }
+  return n;
+}
 
-  if (pickA) {
-    outEvent = nextA_;
-    hasNextA_ = false;
-    return true;
-  } else {
-    outEvent = nextB_;
-    hasNextB_ = false;
-    return true;
-  }
+bool StreamMerger::ReadNext(MarketEvent &outEvent) {
+  return ReadBatch(&outEvent, 1) == 1;
 }
 
-} // namespace ArbSim
\ No newline at end of file
+} // namespace ArbSim
@@ -1,36 +1,48 @@
 #ifndef STREAM_MERGER_H
 #define STREAM_MERGER_H
 
-#include "CsvReader.h"
+#include "BufferedInput.h"
+#include "IEventSource.h"
 #include "MarketData.h"
-#include <random> // Required for random engine
+#include "TieBreak.h"
+#include <limits>
 
 namespace ArbSim {
 
 class StreamMerger {
 public:  
-  StreamMerger(CsvReader &readerA, CsvReader &readerB, unsigned int seed = 42);
+  // Events pulled from each reader per refill
+  static constexpr size_t kInputBlockEvents = 1024;
+
+  StreamMerger(IEventSource &readerA, IEventSource &readerB, unsigned int seed = 42);
 
   bool ReadNext(MarketEvent &outEvent);
 
-private:
-  CsvReader &readerA_;
-  CsvReader &readerB_;
+  // Merges up to max events into out; returns the number written (0 once
+  // both inputs are exhausted). Same order as repeated ReadNext() calls,
+  // and the two may be mixed.
+  size_t ReadBatch(MarketEvent *out, size_t max);
 
-  MarketEvent nextA_;
-  MarketEvent nextB_;
+  // Restricts output to startTime <= sendingTime < endTime. Each input stops
+  // being read at its first event at or after endTime. Seeking the readers
+  // to startTime beforehand (IEventSource::SeekToTime) avoids reading the
+  // skipped prefix.
+  void SetTimeWindow(long long startTime, long long endTime);
+
+private:
+  BufferedInput a_;
+  BufferedInput b_;
 
-  bool hasNextA_;
-  bool hasNextB_;
+  // Time window (whole stream by default)
+  long long startTime_;
+  long long endTime_;
 
-  // Deterministic Random Number Generator
-  std::mt19937 rng_;
-  std::uniform_int_distribution<int> coinFlip_;
+  // Deterministic, per-event tie-breaking (see TieBreak.h)
+  TieBreaker tieBreaker_;
 
-  void LoadNextAIfNeeded();
-  void LoadNextBIfNeeded();
+  static size_t CopyRun(BufferedInput &input, MarketEvent *out, size_t max);
 };
 
 } // namespace ArbSim
 
-#endif // STREAM_MERGER_H
\ No newline at end of file
+#endif // STREAM_MERGER_H
@@ -0,0 +1,49 @@
+#include "ThreadPool.h"
+
+namespace ArbSim {
+
+ThreadPool::ThreadPool(size_t threads) : stopping_(false) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::Size() const { return workers_.size(); }
+
+void ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return; // stopping and drained
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    // packaged_task stores exceptions in the future
+    task();
+  }
+}
+
+} // namespace ArbSim
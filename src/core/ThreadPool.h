@@ -0,0 +1,62 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ArbSim {
+
+// Fixed-size pool of worker threads running tasks in submission order.
+// Exceptions thrown by a task are delivered through its future.
+class ThreadPool {
+public:
+  // threads == 0 uses std::thread::hardware_concurrency()
+  explicit ThreadPool(size_t threads = 0);
+  // Runs every task already submitted, then joins the workers
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t Size() const;
+
+  template <typename F>
+  std::future<std::invoke_result_t<std::decay_t<F>>> Submit(F &&task) {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(task));
+    std::future<Result> future = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_) {
+        throw std::runtime_error("ThreadPool: Submit after shutdown");
+      }
+      tasks_.emplace_back([packaged]() { (*packaged)(); });
+    }
+    wake_.notify_one();
+    return future;
+  }
+
+private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_;
+
+  void WorkerLoop();
+};
+
+} // namespace ArbSim
+
+#endif // THREAD_POOL_H
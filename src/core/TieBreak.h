@@ -0,0 +1,57 @@
+#ifndef TIE_BREAK_H
+#define TIE_BREAK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ArbSim {
+
+// Changes whenever the merged order for a given seed does; persisted merge
+// results (TimelineCache file names) carry it so stale ones are not reused.
+constexpr unsigned int kTieBreakVersion = 2;
+
+// splitmix64 finalizer
+inline uint64_t TieBreakMix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// Priority of one source's ordinal-th event at a timestamp among the events
+// of other sources at that timestamp: the lower key goes first.
+inline uint64_t TieBreakKey(uint64_t seed, long long time, size_t source,
+                            uint64_t ordinal) {
+  const uint64_t h =
+      TieBreakMix(seed ^ TieBreakMix(static_cast<uint64_t>(time)));
+  return TieBreakMix(TieBreakMix(h + source) + ordinal);
+}
+
+// Order of two sources' heads at the same sendingTime. Each head's key
+// depends only on (seed, sendingTime, source index, how many events that
+// source already had at that sendingTime), never on which comparisons a
+// merger happened to make, so the keys totally order every tie and any
+// range of the day that starts on a new timestamp merges exactly as it
+// does inside a full-day run, whatever the number of sources.
+class TieBreaker {
+public:
+  explicit TieBreaker(unsigned int seed) : seed_(seed) {}
+
+  // True if source x's ordinalX-th event at `time` goes before source y's
+  // ordinalY-th one
+  bool PickFirst(long long time, size_t x, uint64_t ordinalX, size_t y,
+                 uint64_t ordinalY) const {
+    const uint64_t kx = TieBreakKey(seed_, time, x, ordinalX);
+    const uint64_t ky = TieBreakKey(seed_, time, y, ordinalY);
+    return kx != ky ? kx < ky : x < y;
+  }
+
+private:
+  uint64_t seed_;
+};
+
+} // namespace ArbSim
+
+#endif // TIE_BREAK_H
@@ -0,0 +1,187 @@
+#include "TimeIndex.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace ArbSim {
+
+namespace {
+
+constexpr char kTimeIndexMagic[8] = {'A', 'R', 'B', 'S', 'I', 'M', 'I', 'X'};
+constexpr uint32_t kTimeIndexVersion = 1;
+
+struct TimeIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t stride;
+  uint64_t sourceSize;  // size of the CSV the index was built from
+  int64_t sourceMtime;  // its last write time (file clock ticks)
+  uint64_t count;
+};
+
+static_assert(sizeof(TimeIndexHeader) == 40, "TimeIndexHeader layout");
+static_assert(sizeof(TimeIndexEntry) == 16, "TimeIndexEntry layout");
+
+int64_t LastWriteTicks(const std::string &path) {
+  return static_cast<int64_t>(
+      fs::last_write_time(path).time_since_epoch().count());
+}
+
+} // namespace
+
+std::string TimeIndex::SidecarPath(const std::string &csvPath) {
+  return csvPath + ".idx";
+}
+
+TimeIndex TimeIndex::LoadOrBuild(const std::string &csvPath, size_t stride) {
+  stride = stride > 0 ? stride : 1;
+  std::error_code ec;
+  const uint64_t size = fs::file_size(csvPath, ec);
+  if (ec) {
+    throw std::runtime_error("TimeIndex: Failed to open file: " + csvPath);
+  }
+  const int64_t mtime = LastWriteTicks(csvPath);
+  const std::string sidecar = SidecarPath(csvPath);
+
+  TimeIndex index;
+  if (index.Load(sidecar, size, mtime, stride)) {
+    return index;
+  }
+
+  MappedFile mapped(csvPath);
+  index = Build(mapped.Data(), mapped.Size(), stride);
+  index.Save(sidecar, size, mtime);
+  return index;
+}
+
+TimeIndex TimeIndex::Build(const char *data, size_t size, size_t stride) {
+  TimeIndex index;
+  index.stride_ = stride > 0 ? stride : 1;
+
+  const char *p = data;
+  const char *const end = data + size;
+  size_t row = 0;
+  while (p < end) {
+    const char *eol =
+        static_cast<const char *>(std::memchr(p, '\n', end - p));
+    if (eol == nullptr) {
+      eol = end;
+    }
+
+    // Empty lines are skipped by the reader, so they are not rows
+    if (eol != p && !(eol - p == 1 && *p == '\r')) {
+      if (row % index.stride_ == 0) {
+        const char *q = p;
+        while (q < eol && (*q == ' ' || *q == '\t')) {
+          ++q;
+        }
+        long long time = 0;
+        // A malformed row is left out; the reader reports it when reached
+        if (std::from_chars(q, eol, time).ec == std::errc()) {
+          index.entries_.push_back(
+              {time, static_cast<uint64_t>(p - data)});
+        }
+      }
+      ++row;
+    }
+    p = eol + 1;
+  }
+  return index;
+}
+
+uint64_t TimeIndex::FindOffset(int64_t time) const {
+  // Last sample strictly earlier than `time`: rows before it are not later
+  // than it, so none of them can be in the window.
+  const auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), time,
+      [](const TimeIndexEntry &e, int64_t t) { return e.sendingTime < t; });
+  if (it == entries_.begin()) {
+    return 0;
+  }
+  return std::prev(it)->offset;
+}
+
+size_t TimeIndex::GetStride() const { return stride_; }
+
+const std::vector<TimeIndexEntry> &TimeIndex::GetEntries() const {
+  return entries_;
+}
+
+bool TimeIndex::WasLoaded() const { return loaded_; }
+
+bool TimeIndex::Save(const std::string &path, uint64_t sourceSize,
+                     int64_t sourceMtime) const {
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  if (!f.is_open()) {
+    return false;
+  }
+
+  TimeIndexHeader header{};
+  std::memcpy(header.magic, kTimeIndexMagic, sizeof(header.magic));
+  header.version = kTimeIndexVersion;
+  header.stride = static_cast<uint32_t>(stride_);
+  header.sourceSize = sourceSize;
+  header.sourceMtime = sourceMtime;
+  header.count = entries_.size();
+
+  f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  f.write(reinterpret_cast<const char *>(entries_.data()),
+          static_cast<std::streamsize>(entries_.size() *
+                                       sizeof(TimeIndexEntry)));
+  f.close();
+  if (!f) {
+    std::remove(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool TimeIndex::Load(const std::string &path, uint64_t sourceSize,
+                     int64_t sourceMtime, size_t stride) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f.is_open()) {
+    return false;
+  }
+
+  TimeIndexHeader header{};
+  if (!f.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+  // Any mismatch means a stale or foreign sidecar: rebuild it
+  if (std::memcmp(header.magic, kTimeIndexMagic, sizeof(header.magic)) != 0 ||
+      header.version != kTimeIndexVersion || header.stride != stride ||
+      header.sourceSize != sourceSize || header.sourceMtime != sourceMtime) {
+    return false;
+  }
+  std::error_code ec;
+  const uint64_t fileSize = fs::file_size(path, ec);
+  // Bound the count before multiplying so a corrupt one cannot wrap around
+  if (ec || fileSize < sizeof(header) ||
+      header.count > (fileSize - sizeof(header)) / sizeof(TimeIndexEntry) ||
+      fileSize != sizeof(header) + header.count * sizeof(TimeIndexEntry)) {
+    return false;
+  }
+
+  std::vector<TimeIndexEntry> entries(header.count);
+  if (!f.read(reinterpret_cast<char *>(entries.data()),
+              static_cast<std::streamsize>(header.count *
+                                           sizeof(TimeIndexEntry)))) {
+    return false;
+  }
+
+  stride_ = stride;
+  entries_ = std::move(entries);
+  loaded_ = true;
+  return true;
+}
+
+} // namespace ArbSim
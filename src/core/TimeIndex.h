@@ -0,0 +1,59 @@
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+// One sample of a sparse index: the sendingTime of a row and the byte
+// offset of the start of that row.
+struct TimeIndexEntry {
+  int64_t sendingTime;
+  uint64_t offset;
+};
+
+// Sparse sendingTime -> byte offset index over a time-sorted CSV file,
+// sampling every `stride` rows. It is saved next to the CSV as
+// "<file>.idx" and rebuilt when the CSV's size or modification time no
+// longer match the ones recorded in the sidecar.
+class TimeIndex {
+public:
+  static constexpr size_t kDefaultStride = 4096;
+
+  // Loads the sidecar if it is current, otherwise builds the index from the
+  // CSV and tries to save it (a read-only directory is not an error).
+  static TimeIndex LoadOrBuild(const std::string &csvPath,
+                               size_t stride = kDefaultStride);
+
+  // Builds an index over CSV bytes already in memory
+  static TimeIndex Build(const char *data, size_t size, size_t stride);
+
+  static std::string SidecarPath(const std::string &csvPath);
+
+  // Offset of a row at or before the first row with sendingTime >= time:
+  // every row before the returned offset is earlier than `time`.
+  uint64_t FindOffset(int64_t time) const;
+
+  size_t GetStride() const;
+  const std::vector<TimeIndexEntry> &GetEntries() const;
+
+  // True if LoadOrBuild() used an existing sidecar
+  bool WasLoaded() const;
+
+private:
+  size_t stride_ = kDefaultStride;
+  std::vector<TimeIndexEntry> entries_;
+  bool loaded_ = false;
+
+  bool Save(const std::string &path, uint64_t sourceSize,
+            int64_t sourceMtime) const;
+  bool Load(const std::string &path, uint64_t sourceSize, int64_t sourceMtime,
+            size_t stride);
+};
+
+} // namespace ArbSim
+
+#endif // TIME_INDEX_H
@@ -0,0 +1,50 @@
+#include "TimeWindowEventSource.h"
+
+namespace ArbSim {
+
+TimeWindowEventSource::TimeWindowEventSource(
+    std::unique_ptr<IEventSource> inner, long long startTime,
+    long long endTime)
+    : inner_(std::move(inner)), startTime_(startTime), endTime_(endTime),
+      finished_(false) {}
+
+const std::string &TimeWindowEventSource::GetFilePath() const {
+  return inner_->GetFilePath();
+}
+
+bool TimeWindowEventSource::ReadNextEvent(MarketEvent &event) {
+  return ReadEvents(&event, 1) == 1;
+}
+
+size_t TimeWindowEventSource::ReadEvents(MarketEvent *out, size_t max) {
+  // Compact the kept events in place; an all-prefix block reads again so
+  // that 0 still means end of stream
+  while (!finished_ && max > 0) {
+    const size_t n = inner_->ReadEvents(out, max);
+    if (n == 0) {
+      finished_ = true;
+      break;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const long long t = out[i].sendingTime;
+      if (t >= endTime_) {
+        finished_ = true;
+        break;
+      }
+      if (t >= startTime_) {
+        out[kept++] = out[i];
+      }
+    }
+    if (kept > 0) {
+      return kept;
+    }
+  }
+  return 0;
+}
+
+void TimeWindowEventSource::PrintStats(std::ostream &out) const {
+  inner_->PrintStats(out);
+}
+
+} // namespace ArbSim
@@ -0,0 +1,36 @@
+#ifndef TIME_WINDOW_EVENT_SOURCE_H
+#define TIME_WINDOW_EVENT_SOURCE_H
+
+#include "IEventSource.h"
+#include "MarketData.h"
+
+#include <memory>
+
+namespace ArbSim {
+
+// Restricts another time-ordered event source to
+// startTime <= sendingTime < endTime, the way StreamMerger::SetTimeWindow
+// does for two inputs. The inner source stops being read at its first event
+// at or after endTime; seeking it to startTime beforehand
+// (IEventSource::SeekToTime) avoids reading the skipped prefix. Used for a
+// single pre-merged stream such as the cached timeline.
+class TimeWindowEventSource : public IEventSource {
+public:
+  TimeWindowEventSource(std::unique_ptr<IEventSource> inner,
+                        long long startTime, long long endTime);
+
+  const std::string &GetFilePath() const override;
+  bool ReadNextEvent(MarketEvent &event) override;
+  size_t ReadEvents(MarketEvent *out, size_t max) override;
+  void PrintStats(std::ostream &out) const override;
+
+private:
+  std::unique_ptr<IEventSource> inner_;
+  long long startTime_;
+  long long endTime_;
+  bool finished_;
+};
+
+} // namespace ArbSim
+
+#endif // TIME_WINDOW_EVENT_SOURCE_H
@@ -0,0 +1,130 @@
+#include "TimelineCache.h"
+
+#include "BinaryEventFile.h"
+#include "Constants.h"
+#include "EventSourceFactory.h"
+#include "MappedFile.h"
+#include "StreamMerger.h"
+#include "TieBreak.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace ArbSim {
+
+uint64_t TimelineCache::HashFile(const std::string &filePath) {
+  MappedFile file(filePath);
+  file.AdviseSequential();
+  const char *p = file.Data();
+  const size_t size = file.Size();
+
+  // Word-at-a-time multiply/xorshift, finalized with splitmix64; fast enough
+  // that hashing both inputs costs about as much as reading them
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t w;
+    std::memcpy(&w, p + i, sizeof(w));
+    h = (h ^ w) * 0xff51afd7ed558ccdULL;
+    h ^= h >> 32;
+  }
+  if (i < size) {
+    uint64_t w = 0;
+    std::memcpy(&w, p + i, size - i);
+    h = (h ^ w) * 0xff51afd7ed558ccdULL;
+  }
+  return TieBreakMix(h);
+}
+
+std::string TimelineCache::CachePath(const std::string &cacheDir,
+                                     uint64_t hashA, uint64_t hashB,
+                                     unsigned int seed) {
+  char name[96];
+  std::snprintf(name, sizeof(name), "timeline-%016llx-%016llx-%u-v%u.bin",
+                static_cast<unsigned long long>(hashA),
+                static_cast<unsigned long long>(hashB), seed,
+                kTieBreakVersion);
+  return (fs::path(cacheDir) / name).string();
+}
+
+uint64_t TimelineCache::Build(const std::string &cachePath, IEventSource &a,
+                              IEventSource &b, unsigned int seed) {
+  const std::string tmpPath =
+      cachePath + ".tmp" +
+      std::to_string(
+          std::chrono::steady_clock::now().time_since_epoch().count());
+
+  uint64_t count = 0;
+  try {
+    BinaryEventWriter writer(tmpPath);
+    StreamMerger merger(a, b, seed);
+    std::vector<MarketEvent> batch(kEventBatchSize);
+    size_t n = 0;
+    while ((n = merger.ReadBatch(batch.data(), batch.size())) > 0) {
+      for (size_t i = 0; i < n; ++i) {
+        writer.Write(batch[i]);
+      }
+    }
+    writer.Close();
+    count = writer.GetCount();
+  } catch (...) {
+    std::error_code ignored;
+    fs::remove(tmpPath, ignored);
+    throw;
+  }
+
+  std::error_code ec;
+  fs::rename(tmpPath, cachePath, ec);
+  if (ec) {
+    fs::remove(tmpPath, ec);
+    throw std::runtime_error("TimelineCache: Failed to save cache: " +
+                             cachePath);
+  }
+  return count;
+}
+
+std::unique_ptr<IEventSource>
+TimelineCache::Open(const std::string &cacheDir, const std::string &pathA,
+                    const std::string &pathB, unsigned int seed,
+                    ThreadPool *parsePool, bool *built) {
+  if (built != nullptr) {
+    *built = false;
+  }
+
+  const std::string cachePath =
+      CachePath(cacheDir, HashFile(pathA), HashFile(pathB), seed);
+
+  if (fs::exists(cachePath)) {
+    try {
+      return std::make_unique<BinaryEventReader>(cachePath);
+    } catch (const std::runtime_error &) {
+      // Unreadable (e.g. written by another version): rebuild below
+    }
+  }
+
+  std::error_code ec;
+  fs::create_directories(cacheDir, ec);
+  if (ec) {
+    throw std::runtime_error("TimelineCache: Failed to create directory: " +
+                             cacheDir);
+  }
+
+  {
+    std::unique_ptr<IEventSource> readerA = OpenEventSource(pathA, parsePool);
+    std::unique_ptr<IEventSource> readerB = OpenEventSource(pathB, parsePool);
+    Build(cachePath, *readerA, *readerB, seed);
+  }
+  if (built != nullptr) {
+    *built = true;
+  }
+  return std::make_unique<BinaryEventReader>(cachePath);
+}
+
+} // namespace ArbSim
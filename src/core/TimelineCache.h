@@ -0,0 +1,47 @@
+#ifndef TIMELINE_CACHE_H
+#define TIMELINE_CACHE_H
+
+#include "IEventSource.h"
+#include "ThreadPool.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ArbSim {
+
+// Persisted result of merging FutureA and FutureB: the full-day, tie-broken
+// StreamMerger output written once as a binary event file, named after a
+// hash of each input's contents, the merge seed and the tie-break version:
+//
+//   <cacheDir>/timeline-<hashA>-<hashB>-<seed>-v<kTieBreakVersion>.bin
+//
+// Later runs over the same inputs replay that file directly. Because ties
+// are broken per timestamp (TieBreak.h), a time window cut from the cached
+// day is identical to merging that window from the inputs.
+class TimelineCache {
+public:
+  // 64-bit hash of a file's bytes (not cryptographic)
+  static uint64_t HashFile(const std::string &filePath);
+
+  static std::string CachePath(const std::string &cacheDir, uint64_t hashA,
+                               uint64_t hashB, unsigned int seed);
+
+  // Merges a and b from their current position and writes the result to
+  // cachePath (through a temporary file renamed into place, so readers
+  // never see a partial cache). Returns the number of events written.
+  static uint64_t Build(const std::string &cachePath, IEventSource &a,
+                        IEventSource &b, unsigned int seed);
+
+  // Opens the cached timeline for the two files, merging and saving it
+  // first if it is missing or unreadable. Creates cacheDir if needed.
+  // built (optional) reports whether the cache had to be written.
+  static std::unique_ptr<IEventSource>
+  Open(const std::string &cacheDir, const std::string &pathA,
+       const std::string &pathB, unsigned int seed,
+       ThreadPool *parsePool = nullptr, bool *built = nullptr);
+};
+
+} // namespace ArbSim
+
+#endif // TIMELINE_CACHE_H
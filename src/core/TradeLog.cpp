@@ -0,0 +1,204 @@
+#include "TradeLog.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace ArbSim {
+
+namespace {
+
+const char *InstrumentName(uint8_t instrument) {
+  switch (static_cast<InstrumentId>(instrument)) {
+  case InstrumentId::FutureA:
+    return "FutureA";
+  case InstrumentId::FutureB:
+    return "FutureB";
+  default:
+    return "Unknown";
+  }
+}
+
+const char *ReasonTag(TradeReason reason) {
+  switch (reason) {
+  case TradeReason::StopLoss:
+    return "STOP_LOSS_CLOSE";
+  case TradeReason::EndOfDay:
+    return "EOD_CLOSE";
+  case TradeReason::Signal:
+  default:
+    return nullptr;
+  }
+}
+
+char *Put(char *p, const char *text) {
+  const size_t n = std::strlen(text);
+  std::memcpy(p, text, n);
+  return p + n;
+}
+
+} // namespace
+
+size_t FormatTrade(const TradeRecord &trade, char *buf, size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  // The longest line is under 100 characters
+  char line[128];
+  char *const end = line + sizeof(line);
+  char *p = std::to_chars(line, end, static_cast<long long>(trade.time)).ptr;
+  p = Put(p, static_cast<Side>(trade.side) == Side::Buy ? ",BUY," : ",SELL,");
+  p = Put(p, InstrumentName(trade.instrument));
+  *p++ = ',';
+  p = std::to_chars(p, end, trade.quantity).ptr;
+  *p++ = ',';
+  // to_chars with a precision is printf's %.10g
+  p = std::to_chars(p, end, TicksToPrice(trade.priceTicks),
+                    std::chars_format::general, 10)
+          .ptr;
+  if (const char *tag = ReasonTag(trade.reason)) {
+    *p++ = ',';
+    p = Put(p, tag);
+  }
+
+  const size_t n = std::min(static_cast<size_t>(p - line), size - 1);
+  std::memcpy(buf, line, n);
+  buf[n] = '\0';
+  return n;
+}
+
+StringTradeSink::StringTradeSink(std::string &out) : out_(out) {}
+
+void StringTradeSink::OnTrade(const TradeRecord &trade) {
+  char buf[160];
+  const size_t n = FormatTrade(trade, buf, sizeof(buf));
+  if (n > 0) {
+    out_.append(buf, n);
+    out_.push_back('\n');
+  }
+}
+
+size_t StringTradeSink::GetPeakMemoryBytes() const {
+  // Strings only grow: the capacity is the high-water mark
+  return out_.capacity();
+}
+
+// --- CountingTradeSink ---
+
+CountingTradeSink::CountingTradeSink() : count_(0) {}
+
+void CountingTradeSink::OnTrade(const TradeRecord & /*trade*/) { ++count_; }
+
+size_t CountingTradeSink::GetPeakMemoryBytes() const { return 0; }
+
+uint64_t CountingTradeSink::GetCount() const { return count_; }
+
+// --- SpillingTradeSink ---
+
+SpillingTradeSink::SpillingTradeSink(size_t memoryCapBytes)
+    : memoryCap_(std::max(memoryCapBytes, kMinMemoryCap)), spill_(nullptr),
+      spilledBytes_(0), peakBytes_(0) {}
+
+SpillingTradeSink::~SpillingTradeSink() {
+  if (spill_ != nullptr) {
+    std::fclose(spill_);
+  }
+}
+
+void SpillingTradeSink::OnTrade(const TradeRecord &trade) {
+  char line[160];
+  const size_t n = FormatTrade(trade, line, sizeof(line));
+  if (n == 0) {
+    return;
+  }
+  if (buffer_.size() + n + 1 > memoryCap_) {
+    Spill();
+  }
+  if (buffer_.size() + n + 1 > buffer_.capacity()) {
+    // Grow geometrically, but never past the cap
+    buffer_.reserve(std::min(
+        memoryCap_, std::max(2 * buffer_.capacity(), buffer_.size() + n + 1)));
+    peakBytes_ = std::max(peakBytes_, buffer_.capacity());
+  }
+  buffer_.insert(buffer_.end(), line, line + n);
+  buffer_.push_back('\n');
+}
+
+void SpillingTradeSink::Spill() {
+  if (spill_ == nullptr) {
+    spill_ = std::tmpfile();
+    if (spill_ == nullptr) {
+      throw std::runtime_error(
+          "SpillingTradeSink: Failed to create a temp file for the trade log");
+    }
+  }
+  if (std::fwrite(buffer_.data(), 1, buffer_.size(), spill_) !=
+      buffer_.size()) {
+    throw std::runtime_error("SpillingTradeSink: Failed to spill " +
+                             std::to_string(buffer_.size()) +
+                             " bytes of the trade log");
+  }
+  spilledBytes_ += buffer_.size();
+  buffer_.clear();
+}
+
+void SpillingTradeSink::WriteTo(OutputBuffer &out) {
+  if (spill_ != nullptr) {
+    std::fflush(spill_);
+    std::rewind(spill_);
+    // Read the spilled text back in chunks of at most 64KB
+    std::vector<char> chunk(std::min<size_t>(memoryCap_, 1 << 16));
+    uint64_t remaining = spilledBytes_;
+    while (remaining > 0) {
+      const size_t want =
+          static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+      if (std::fread(chunk.data(), 1, want, spill_) != want) {
+        throw std::runtime_error(
+            "SpillingTradeSink: Failed to read back the spilled trade log");
+      }
+      out.Append(chunk.data(), want);
+      remaining -= want;
+    }
+    std::fseek(spill_, 0, SEEK_END);
+  }
+  out.Append(buffer_.data(), buffer_.size());
+}
+
+size_t SpillingTradeSink::GetPeakMemoryBytes() const { return peakBytes_; }
+
+uint64_t SpillingTradeSink::GetSpilledBytes() const { return spilledBytes_; }
+
+std::vector<TradeRecord> ReadTradeLogFile(const std::string &filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("ReadTradeLogFile: Failed to open file: " +
+                             filePath);
+  }
+
+  TradeLogHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kTradeLogMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("ReadTradeLogFile: Not a trade log: " + filePath);
+  }
+  if (header.version != kTradeLogVersion ||
+      header.recordSize != sizeof(TradeRecord)) {
+    throw std::runtime_error("ReadTradeLogFile: Unsupported version " +
+                             std::to_string(header.version) + " in: " +
+                             filePath);
+  }
+
+  std::vector<TradeRecord> trades(static_cast<size_t>(header.count));
+  if (!trades.empty() &&
+      !file.read(reinterpret_cast<char *>(trades.data()),
+                 static_cast<std::streamsize>(trades.size() *
+                                              sizeof(TradeRecord)))) {
+    throw std::runtime_error("ReadTradeLogFile: Truncated trade log: " +
+                             filePath);
+  }
+  return trades;
+}
+
+} // namespace ArbSim
@@ -0,0 +1,134 @@
+#ifndef TRADE_LOG_H
+#define TRADE_LOG_H
+
+#include "MarketData.h"
+#include "OutputBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ArbSim {
+
+// Why a fill happened; closes carry a tag in the text log
+enum class TradeReason : uint8_t {
+  Signal,   // strategy entry at the B touch
+  StopLoss, // STOP_LOSS_CLOSE at mid
+  EndOfDay, // EOD_CLOSE at mid
+};
+
+// One fill as the engine produces it: fixed-width, no strings, so the hot
+// path only copies 32 bytes. Formatting happens in the sink.
+struct TradeRecord {
+  int64_t time;       // sendingTime of the triggering event
+  int64_t priceTicks; // fill price in ticks (MarketData.h)
+  uint64_t sequence;  // 0, 1, 2, ... per engine
+  int32_t quantity;
+  uint8_t side;       // Side
+  uint8_t instrument; // InstrumentId
+  TradeReason reason;
+  uint8_t reserved;
+};
+
+static_assert(sizeof(TradeRecord) == 32, "TradeRecord layout");
+
+// Receives the engine's fills, in order, on the simulation thread
+class ITradeSink {
+public:
+  virtual ~ITradeSink() = default;
+  virtual void OnTrade(const TradeRecord &trade) = 0;
+  // Most memory the sink has held for trades so far
+  virtual size_t GetPeakMemoryBytes() const = 0;
+};
+
+// Formats a fill as one trade log line, without the newline, exactly as the
+// engine always printed it:
+//   <time>,<BUY|SELL>,<instrument>,<qty>,<price %.10g>[,<close tag>]
+// Returns the length written (truncated to size - 1 like snprintf), or 0.
+size_t FormatTrade(const TradeRecord &trade, char *buf, size_t size);
+
+// Appends formatted lines to a string (the in-memory trade log)
+class StringTradeSink : public ITradeSink {
+public:
+  explicit StringTradeSink(std::string &out);
+  void OnTrade(const TradeRecord &trade) override;
+  size_t GetPeakMemoryBytes() const override;
+
+private:
+  std::string &out_;
+};
+
+// Counts fills and keeps nothing: for runs that report only a summary
+// (parameter sweeps, batch days), so memory stays flat however many fills
+class CountingTradeSink : public ITradeSink {
+public:
+  CountingTradeSink();
+  void OnTrade(const TradeRecord &trade) override;
+  size_t GetPeakMemoryBytes() const override;
+
+  uint64_t GetCount() const;
+
+private:
+  uint64_t count_;
+};
+
+// Text trade log with a memory cap. Lines collect in a buffer of at most
+// memoryCapBytes; when the next line does not fit, the buffer is appended to
+// an anonymous temp file (std::tmpfile, deleted when closed) and reused.
+// WriteTo() streams the spilled text and then the buffer, so the output
+// equals StringTradeSink's whatever the cap.
+class SpillingTradeSink : public ITradeSink {
+public:
+  // Caps below kMinMemoryCap are raised to it (room for any one line)
+  static constexpr size_t kMinMemoryCap = 4096;
+
+  explicit SpillingTradeSink(size_t memoryCapBytes);
+  ~SpillingTradeSink() override;
+
+  SpillingTradeSink(const SpillingTradeSink &) = delete;
+  SpillingTradeSink &operator=(const SpillingTradeSink &) = delete;
+
+  void OnTrade(const TradeRecord &trade) override;
+  size_t GetPeakMemoryBytes() const override;
+
+  // Writes the whole log to out; throws std::runtime_error if the spill file
+  // cannot be read back. Can be called once trading is done.
+  void WriteTo(OutputBuffer &out);
+
+  uint64_t GetSpilledBytes() const;
+
+private:
+  const size_t memoryCap_;
+  std::vector<char> buffer_;
+  std::FILE *spill_;
+  uint64_t spilledBytes_;
+  size_t peakBytes_;
+
+  void Spill();
+};
+
+// Binary trade log file: one header followed by `count` TradeRecords, in
+// host byte order (same conventions as BinaryEventFile.h).
+constexpr char kTradeLogMagic[8] = {'A', 'R', 'B', 'S', 'I', 'M', 'T', 'R'};
+constexpr uint32_t kTradeLogVersion = 1;
+
+struct TradeLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t count;
+  uint8_t reserved[8];
+};
+
+static_assert(sizeof(TradeLogHeader) == 32, "TradeLogHeader layout");
+
+// Reads a whole binary trade log; throws std::runtime_error if the file is
+// not one or is truncated
+std::vector<TradeRecord> ReadTradeLogFile(const std::string &filePath);
+
+} // namespace ArbSim
+
+#endif // TRADE_LOG_H
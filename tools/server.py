@@ -43,10 +43,15 @@ import argparse
 PROJECT_ROOT = os.getcwd() 
 DATA_DIR = os.path.join(PROJECT_ROOT, 'data')
 CONFIG_PATH = os.path.join(PROJECT_ROOT, 'config', 'config.cfg')
+# The engine writes the PnL chart here (PnlSeries.Path) instead of printing it
+PNL_SERIES_PATH = os.path.join(DATA_DIR, 'pnl_series.ndjson')
+PNL_SERIES_INTERVAL_MS = 1000
 
 # Argument Parsing
 parser = argparse.ArgumentParser(description='ArbSim Dashboard Server')
 parser.add_argument('--exe', type=str, help='Path to ArbSim executable')
+parser.add_argument('--chart-points', type=int, default=2000,
+                    help='Most PnL points per chart; the engine thins the series to this (PnlSeries.MaxPoints, 0 = all)')
 args, unknown = parser.parse_known_args()
 
 # EXE Path Resolution Priority:
@@ -97,21 +102,27 @@ def load_config():
     return cfg
 
 def update_config(x, y, z):
-    # Load existing to preserve paths
+    # Load existing to preserve paths and any other keys
     cfg = load_config()
     
     # Default paths if missing
-    future_a = cfg.get('Data.FutureA', os.path.join(DATA_DIR, 'futureA.csv').replace('\\', '/'))
-    future_b = cfg.get('Data.FutureB', os.path.join(DATA_DIR, 'futureB.csv').replace('\\', '/'))
-    
-    config_content = f"""Data.FutureA={future_a}
-Data.FutureB={future_b}
-Strategy.MinArbitrageEdge={x}
-Strategy.MaxAbsExposureLots={y}
-Strategy.StopLossPnl={z}
-"""
+    cfg.setdefault('Data.FutureA', os.path.join(DATA_DIR, 'futureA.csv').replace('\\', '/'))
+    cfg.setdefault('Data.FutureB', os.path.join(DATA_DIR, 'futureB.csv').replace('\\', '/'))
+    # Runs repeat over the same data: keep the merged timeline between them
+    cfg.setdefault('Data.CacheDir', os.path.join(DATA_DIR, 'cache').replace('\\', '/'))
+
+    cfg['Strategy.MinArbitrageEdge'] = x
+    cfg['Strategy.MaxAbsExposureLots'] = y
+    cfg['Strategy.StopLossPnl'] = z
+    # The chart comes from the PnL series file, sampled every second
+    cfg['PnlSeries.Path'] = PNL_SERIES_PATH.replace('\\', '/')
+    cfg['PnlSeries.Format'] = 'ndjson'
+    cfg.setdefault('PnlSeries.IntervalMs', PNL_SERIES_INTERVAL_MS)
+    cfg['PnlSeries.MaxPoints'] = args.chart_points
+
     with open(CONFIG_PATH, 'w') as f:
-        f.write(config_content)
+        for key, val in cfg.items():
+            f.write(f"{key}={val}\n")
 
 @app.route('/api/config', methods=['GET'])
 def get_config():
@@ -124,9 +135,20 @@ def get_config():
         'fileB': cfg.get('Data.FutureB', '')
     })
 
-# ... existing parsing logic ...
-
-
+def load_pnl_series(path):
+    """Read the engine's NDJSON PnL series into chart points."""
+    chart_data = []
+    with open(path, 'r') as f:
+        for line in f:
+            if not line.strip():
+                continue
+            sample = json.loads(line)
+            chart_data.append({
+                'time': sample['time'],
+                'pnl': sample['pnl'],
+                'priceB': sample['midB']
+            })
+    return chart_data
 
 def parse_trades_and_pnl(stdout_data):
     trades = []
@@ -195,6 +217,9 @@ def run_simulation():
     z = data.get('z', -100000)
     
     update_config(x, y, z)
+    # A failed run must not show the previous run's chart
+    if os.path.exists(PNL_SERIES_PATH):
+        os.remove(PNL_SERIES_PATH)
     
     try:
         # Run C++ App with timeout protection
@@ -207,6 +232,8 @@ def run_simulation():
         )
 
         trades, summary, chart_data = parse_trades_and_pnl(result.stdout)
+        if result.returncode == 0 and os.path.exists(PNL_SERIES_PATH):
+            chart_data = load_pnl_series(PNL_SERIES_PATH)
 
         return jsonify({
             'success': True,